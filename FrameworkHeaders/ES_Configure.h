@@ -9,6 +9,22 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 00:25 mp      added ES_SHOW_SCORE and ES_HIDE_SCORE
+ 10/19/26 00:20 mp      SERV_n_POST names each service's post function
+ 10/19/26 00:15 mp      short timer channel 1 is unused, nothing started it
+ 10/19/26 00:05 mp      ES_ShortTimer_CheckExpired posts the short timeouts
+ 10/18/26 23:58 mp      added ES_PLAY_ANIM, ES_STOP_ANIM and AnimTimer
+ 10/18/26 23:40 mp      added MarqueeTimer
+ 10/18/26 22:20 mp      added ES_DISPLAY_DONE and its event checker
+ 10/18/26 21:40 mp      added the GAME_TELEMETRY switch
+ 10/18/26 21:00 mp      Service 0 is now the introspection shell
+ 10/18/26 19:15 mp      added log channels, levels and rate for ES_Log.h
+ 10/18/26 17:20 mp      added ES_NEW_LINE
+ 10/18/26 14:20 mp      added timer groups for ES_Timer_StopGroup/RestartGroup
+ 10/18/26 13:10 mp      added ES_TIMEOUT_SET and TIMER_COALESCE_MASK
+ 10/18/26 11:30 mp      added ES_EVENT_TIMESTAMPS switch and the
+                         NUM_ES_EVENT_TYPES sentinel
+ 10/18/26 10:05 mp      added response functions for the short timer channels
  12/19/16 20:19  jec     removed EVENT_CHECK_HEADER definition. This goes with
                          the V2.3 move to a single wrapper for event checking
                          headers
@@ -41,11 +57,13 @@
 // services are added in numeric sequence (1,2,3,...) with increasing
 // priorities
 // the header file with the public function prototypes
-#define SERV_0_HEADER "TestHarnessService0.h"
+#define SERV_0_HEADER "ShellService.h"
 // the name of the Init function
-#define SERV_0_INIT InitTestHarnessService0
+#define SERV_0_INIT InitShellService
 // the name of the run function
-#define SERV_0_RUN RunTestHarnessService0
+#define SERV_0_RUN RunShellService
+// the name of the post function, for checking timer group owners
+#define SERV_0_POST PostShellService
 // How big should this services Queue be?
 #define SERV_0_QUEUE_SIZE 5
 
@@ -62,6 +80,8 @@
 #define SERV_1_INIT InitLEDService
 // the name of the run function
 #define SERV_1_RUN RunLEDService
+// the name of the post function, for checking timer group owners
+#define SERV_1_POST PostLEDService
 // How big should this services Queue be?
 #define SERV_1_QUEUE_SIZE 9
 #endif
@@ -75,6 +95,8 @@
 #define SERV_2_INIT InitModeServiceFSM
 // the name of the run function
 #define SERV_2_RUN RunModeServiceFSM
+// the name of the post function, for checking timer group owners
+#define SERV_2_POST PostModeServiceFSM
 // How big should this services Queue be?
 #define SERV_2_QUEUE_SIZE 5
 #endif
@@ -88,6 +110,8 @@
 #define SERV_3_INIT InitSensorService
 // the name of the run function
 #define SERV_3_RUN RunSensorService
+// the name of the post function, for checking timer group owners
+#define SERV_3_POST PostSensorService
 // How big should this services Queue be?
 #define SERV_3_QUEUE_SIZE 3
 #endif
@@ -101,6 +125,8 @@
 #define SERV_4_INIT InitInstructionService
 // the name of the run function
 #define SERV_4_RUN RunInstructionService
+// the name of the post function, for checking timer group owners
+#define SERV_4_POST PostInstructionService
 // How big should this services Queue be?
 #define SERV_4_QUEUE_SIZE 3
 #endif
@@ -114,6 +140,8 @@
 #define SERV_5_INIT InitVibrationFSM
 // the name of the run function
 #define SERV_5_RUN RunVibrationFSM
+// the name of the post function, for checking timer group owners
+#define SERV_5_POST PostVibrationFSM
 // How big should this services Queue be?
 #define SERV_5_QUEUE_SIZE 3
 #endif
@@ -127,6 +155,8 @@
 #define SERV_6_INIT InitTestHarnessService6
 // the name of the run function
 #define SERV_6_RUN RunTestHarnessService6
+// the name of the post function, for checking timer group owners
+#define SERV_6_POST PostTestHarnessService6
 // How big should this services Queue be?
 #define SERV_6_QUEUE_SIZE 3
 #endif
@@ -140,6 +170,8 @@
 #define SERV_7_INIT InitTestHarnessService7
 // the name of the run function
 #define SERV_7_RUN RunTestHarnessService7
+// the name of the post function, for checking timer group owners
+#define SERV_7_POST PostTestHarnessService7
 // How big should this services Queue be?
 #define SERV_7_QUEUE_SIZE 3
 #endif
@@ -153,6 +185,8 @@
 #define SERV_8_INIT InitTestHarnessService8
 // the name of the run function
 #define SERV_8_RUN RunTestHarnessService8
+// the name of the post function, for checking timer group owners
+#define SERV_8_POST PostTestHarnessService8
 // How big should this services Queue be?
 #define SERV_8_QUEUE_SIZE 3
 #endif
@@ -166,6 +200,8 @@
 #define SERV_9_INIT InitTestHarnessService9
 // the name of the run function
 #define SERV_9_RUN RunTestHarnessService9
+// the name of the post function, for checking timer group owners
+#define SERV_9_POST PostTestHarnessService9
 // How big should this services Queue be?
 #define SERV_9_QUEUE_SIZE 3
 #endif
@@ -179,6 +215,8 @@
 #define SERV_10_INIT InitTestHarnessService10
 // the name of the run function
 #define SERV_10_RUN RunTestHarnessService10
+// the name of the post function, for checking timer group owners
+#define SERV_10_POST PostTestHarnessService10
 // How big should this services Queue be?
 #define SERV_10_QUEUE_SIZE 3
 #endif
@@ -192,6 +230,8 @@
 #define SERV_11_INIT InitTestHarnessService11
 // the name of the run function
 #define SERV_11_RUN RunTestHarnessService11
+// the name of the post function, for checking timer group owners
+#define SERV_11_POST PostTestHarnessService11
 // How big should this services Queue be?
 #define SERV_11_QUEUE_SIZE 3
 #endif
@@ -205,6 +245,8 @@
 #define SERV_12_INIT InitTestHarnessService12
 // the name of the run function
 #define SERV_12_RUN RunTestHarnessService12
+// the name of the post function, for checking timer group owners
+#define SERV_12_POST PostTestHarnessService12
 // How big should this services Queue be?
 #define SERV_12_QUEUE_SIZE 3
 #endif
@@ -218,6 +260,8 @@
 #define SERV_13_INIT InitTestHarnessService13
 // the name of the run function
 #define SERV_13_RUN RunTestHarnessService13
+// the name of the post function, for checking timer group owners
+#define SERV_13_POST PostTestHarnessService13
 // How big should this services Queue be?
 #define SERV_13_QUEUE_SIZE 3
 #endif
@@ -231,6 +275,8 @@
 #define SERV_14_INIT InitTestHarnessService14
 // the name of the run function
 #define SERV_14_RUN RunTestHarnessService14
+// the name of the post function, for checking timer group owners
+#define SERV_14_POST PostTestHarnessService14
 // How big should this services Queue be?
 #define SERV_14_QUEUE_SIZE 3
 #endif
@@ -244,10 +290,18 @@
 #define SERV_15_INIT InitTestHarnessService15
 // the name of the run function
 #define SERV_15_RUN RunTestHarnessService15
+// the name of the post function, for checking timer group owners
+#define SERV_15_POST PostTestHarnessService15
 // How big should this services Queue be?
 #define SERV_15_QUEUE_SIZE 3
 #endif
 
+/****************************************************************************/
+// When ES_EVENT_TIMESTAMPS is defined, every event is stamped as it is posted
+// and ES_Run keeps histograms of the time from post to dispatch, by service
+// and by event type. Comment it out to save the 4 bytes per queue entry.
+#define ES_EVENT_TIMESTAMPS
+
 /****************************************************************************/
 // Name/define the events of interest
 // Universal events occupy the lowest entries, followed by user-defined events
@@ -258,8 +312,10 @@ typedef enum
   ES_INIT,                  /* used to transition from initial pseudo-state */
   ES_TIMEOUT,               /* signals that the timer has expired */
   ES_SHORT_TIMEOUT,         /* signals that a short timer has expired */
+  ES_TIMEOUT_SET,           /* several timers expired, param is their mask */
   /* User-defined events start here */
   ES_NEW_KEY,               /* signals a new key received from terminal */
+  ES_NEW_LINE,              /* a line from the terminal, param is its handle */
   ES_LOCK,
   ES_UNLOCK,
   ES_ADD_CHAR,
@@ -275,7 +331,13 @@ typedef enum
   ES_INSTRUCT,
   ES_STOPINSTRUCT,
   StartMotor,
-  StopMotor
+  StopMotor,
+  ES_DISPLAY_DONE,          /* the display transmitter has sent every latch */
+  ES_PLAY_ANIM,             /* param is the AnimId_t to play */
+  ES_STOP_ANIM,
+  ES_SHOW_SCORE,            /* param is the points to show */
+  ES_HIDE_SCORE,
+  NUM_ES_EVENT_TYPES        /* keep last, sizes the per-event statistics */
 }ES_EventType_t;
 
 /****************************************************************************/
@@ -310,7 +372,7 @@ typedef enum
 
 /****************************************************************************/
 // This is the list of event checking functions
-#define EVENT_CHECK_LIST Check4Keystroke, CheckTouchEvents, CheckShakeEvents, CheckSqueezeEvents, CheckWaveEvents, CheckGameButton, CheckZenButton, CheckAnalogValue
+#define EVENT_CHECK_LIST Check4Keystroke, CheckTouchEvents, CheckShakeEvents, CheckSqueezeEvents, CheckWaveEvents, CheckGameButton, CheckZenButton, CheckAnalogValue, CheckDisplayDone, ES_ShortTimer_CheckExpired
 
 /****************************************************************************/
 // These are the definitions for the post functions to be executed when the
@@ -321,8 +383,8 @@ typedef enum
 #define TIMER_UNUSED ((pPostFunc)0)
 #define TIMER0_RESP_FUNC TIMER_UNUSED
 #define TIMER1_RESP_FUNC TIMER_UNUSED
-#define TIMER2_RESP_FUNC TIMER_UNUSED
-#define TIMER3_RESP_FUNC TIMER_UNUSED
+#define TIMER2_RESP_FUNC PostLEDService
+#define TIMER3_RESP_FUNC PostLEDService
 #define TIMER4_RESP_FUNC PostModeServiceFSM
 #define TIMER5_RESP_FUNC PostModeServiceFSM
 #define TIMER6_RESP_FUNC PostSensorService
@@ -334,7 +396,28 @@ typedef enum
 #define TIMER12_RESP_FUNC PostModeServiceFSM
 #define TIMER13_RESP_FUNC PostModeServiceFSM
 #define TIMER14_RESP_FUNC TIMER_UNUSED
-#define TIMER15_RESP_FUNC PostTestHarnessService0
+#define TIMER15_RESP_FUNC TIMER_UNUSED
+
+/****************************************************************************/
+// Timers in this mask that expire on the same tick and share a response
+// function are reported with a single ES_TIMEOUT_SET event, whose parameter
+// is the mask of the expired timers, rather than one ES_TIMEOUT each. A timer
+// that expires alone is still reported with ES_TIMEOUT. Use 0 to turn this
+// off. Services that own these timers must handle ES_TIMEOUT_SET
+#define TIMER_COALESCE_MASK (BIT4HI | BIT5HI | BIT7HI | BIT8HI | BIT9HI | \
+                             BIT10HI | BIT12HI | BIT13HI)
+
+/****************************************************************************/
+// These are the definitions for the post functions to be executed when the
+// corresponding short (micro-second) timer channel expires. All 4 must be
+// defined. If you are not using a channel, then you should use TIMER_UNUSED
+#define NUM_SHORT_TIMERS 4
+#define SHORT_TIMER0_RESP_FUNC PostModeServiceFSM
+#define SHORT_TIMER1_RESP_FUNC TIMER_UNUSED
+#define SHORT_TIMER2_RESP_FUNC TIMER_UNUSED
+#define SHORT_TIMER3_RESP_FUNC TIMER_UNUSED
+
+#define AudioPulseTimer 0
 
 /****************************************************************************/
 // Give the timer numbers symbolc names to make it easier to move them
@@ -355,6 +438,44 @@ typedef enum
 #define NoTriggerTimer 6
 #define NoTriggerLightTimer 5
 #define NoTrigBlinkLight 4
+#define MarqueeTimer 3
+#define AnimTimer 2
+
+/****************************************************************************/
+// Timer groups for ES_Timer_StopGroup and ES_Timer_RestartGroup, one bit per
+// timer number. All of the timers in a group must post to the service that
+// owns the group, given to those functions as OwnerService
+#define GamePlayTimers ((1u << GameTimer) | (1u << ModuleTimer) | \
+                        (1u << BlinkLightTimer))
+#define ZenPlayTimers ((1u << GameTimer) | (1u << IdleLightTimer))
+
+/****************************************************************************/
+// Log channels and levels for ES_Log.h. Debug builds print banners and
+// other information, production builds only warnings and errors
+#define LOG_CH_LED        0
+#define LOG_CH_SCROLL     1
+#define LOG_CH_VIBRATION  2
+#define NUM_LOG_CHANNELS  3
+
+#ifdef __DEBUG
+#define LOG_LEVEL_DEFAULT ES_LOG_INFO
+#else
+#define LOG_LEVEL_DEFAULT ES_LOG_WARN
+#endif
+#define LOG_LEVEL_LED       LOG_LEVEL_DEFAULT
+#define LOG_LEVEL_SCROLL    LOG_LEVEL_DEFAULT
+#define LOG_LEVEL_VIBRATION LOG_LEVEL_DEFAULT
+
+// each channel may print ES_LOG_BURST messages at once, then ES_LOG_RATE
+// messages per second
+#define ES_LOG_BURST 8
+#define ES_LOG_RATE  20
+
+/****************************************************************************/
+// When GAME_TELEMETRY is defined, ModeServiceFSM sends a binary record for
+// each game and each round over the terminal UART (see GameTelemetry.h).
+// Collect them with Tools/telemetry_stats.py
+#define GAME_TELEMETRY
 
 
 
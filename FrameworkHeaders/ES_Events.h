@@ -8,6 +8,7 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 11:30 mp       added optional TimeStamp, filled in at post time
  10/19/17 14:22 jec      changed include to ES_Cpnfigre to get definition of
                          ES_EventTyp_t
  08/05/13 15:19 jec      modifications to suit new portable type definitions
@@ -28,6 +29,9 @@ typedef struct ES_Event
 {
   ES_EventType_t EventType;      // what kind of event?
   uint16_t EventParam;          // parameter value for use w/ this event
+#ifdef ES_EVENT_TIMESTAMPS
+  uint32_t TimeStamp;           // _HW_GetTimeStamp() when posted
+#endif
 }ES_Event_t;
 
 #endif /* ES_Events_H */
@@ -8,6 +8,9 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 21:00 mp       added ES_PeekServiceQueue and ES_GetReady prototypes
+ 10/18/26 14:20 mp       added ES_PurgeTimeoutEvents prototype
+ 10/18/26 11:30 mp       added latency statistics prototypes
  11/02/13 17:06 jec      added ES_PostToServiceLIFO prototype
  08/05/13 15:00 jec      added #include for ES_Port.h to get portability stuff
  10/17/06 07:41 jec      started coding
@@ -45,5 +48,13 @@ ES_Return_t ES_Run(void);
 bool ES_PostAll(ES_Event_t ThisEvent);
 bool ES_PostToService(uint8_t WhichService, ES_Event_t ThisEvent);
 bool ES_PostToServiceLIFO(uint8_t WhichService, ES_Event_t TheEvent);
+bool ES_PurgeTimeoutEvents(uint8_t WhichService, uint16_t TimerMask);
+uint8_t ES_PeekServiceQueue(uint8_t WhichService, ES_Event_t *pDest,
+    uint8_t MaxCount, uint8_t *pQueueSize);
+uint16_t ES_GetReady(void);
+#ifdef ES_EVENT_TIMESTAMPS
+void ES_PrintLatencyStats(void);
+void ES_ClearLatencyStats(void);
+#endif
 
 #endif   // ES_Framework_H
@@ -0,0 +1,48 @@
+/****************************************************************************
+ Module
+     ES_Inject.h
+
+ Description
+     Framed binary event injection over the terminal UART, so that test rigs
+     can post events without touching the sensors.
+
+ Notes
+     A frame is
+       INJECT_SYNC, length (INJECT_PAYLOAD_LEN),
+       service (or INJECT_BROADCAST for ES_PostAll),
+       EventType (2 bytes, LS byte first), EventParam (2 bytes, LS byte first),
+       CRC-8 (polynomial 0x07, initial value 0) of the length and payload
+     Keystrokes are plain ASCII, so they are never taken for a sync byte.
+     Tools/inject_events.py builds and sends frames from a script.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 20:45 mp      first pass
+*****************************************************************************/
+
+#ifndef ES_INJECT_H
+#define ES_INJECT_H
+
+#include "ES_Types.h"
+
+#define INJECT_SYNC        0xAA
+#define INJECT_BROADCAST   0xFF
+#define INJECT_PAYLOAD_LEN 5
+// a frame that stops for this long (ms) is abandoned, so that a broken
+// frame does not swallow the keystrokes that follow it
+#define INJECT_GAP_MS      20
+
+typedef enum
+{
+  INJECT_NOT_MINE,    // not part of a frame, treat it as a keystroke
+  INJECT_IN_FRAME,    // taken by the frame parser, nothing posted yet
+  INJECT_POSTED       // completed a good frame and its event was posted
+}ES_InjectResult_t;
+
+ES_InjectResult_t ES_Inject_ParseByte(uint8_t NewByte);
+uint32_t ES_Inject_GetFrameCount(void);
+uint32_t ES_Inject_GetErrorCount(void);
+uint8_t ES_Inject_CRC8(const uint8_t *pBytes, uint8_t Count);
+
+#endif /* ES_INJECT_H */
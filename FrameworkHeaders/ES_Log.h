@@ -0,0 +1,86 @@
+/****************************************************************************
+ Module
+     ES_Log.h
+
+ Description
+     Levelled, rate limited diagnostic output on top of DB_printf.
+
+ Notes
+     A module picks its channel (LOG_CH_xxx in ES_Configure.h) and, if it
+     wants something other than LOG_LEVEL_DEFAULT, its level before it
+     includes this file:
+
+         #define ES_LOG_CHANNEL LOG_CH_LED
+         #define ES_LOG_LEVEL   LOG_LEVEL_LED
+         #include "ES_Log.h"
+
+     LOG_ERROR, LOG_WARN, LOG_INFO and LOG_DEBUG take DB_printf arguments.
+     Those above the module's level are removed by the preprocessor, so
+     neither the call nor its format string or arguments are compiled. The
+     rest share a token bucket per channel (ES_LOG_BURST, ES_LOG_RATE), and
+     messages over the limit are counted and reported with the next one
+     that gets through.
+     Only call these from the framework's run functions, not from an ISR.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 19:15 mp      first pass
+*****************************************************************************/
+
+#ifndef ES_LOG_H
+#define ES_LOG_H
+
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "dbprintf.h"
+
+#define ES_LOG_NONE  0
+#define ES_LOG_ERROR 1
+#define ES_LOG_WARN  2
+#define ES_LOG_INFO  3
+#define ES_LOG_DEBUG 4
+
+bool ES_Log_Allow(uint8_t Channel);
+
+#ifdef ES_LOG_CHANNEL
+
+#ifndef ES_LOG_LEVEL
+#define ES_LOG_LEVEL LOG_LEVEL_DEFAULT
+#endif
+
+#define ES_LOG_EMIT(...)                      \
+  do {                                        \
+    if (ES_Log_Allow(ES_LOG_CHANNEL))         \
+    {                                         \
+      DB_printf(__VA_ARGS__);                 \
+    }                                         \
+  } while (0)
+
+#if ES_LOG_LEVEL >= ES_LOG_ERROR
+#define LOG_ERROR(...) ES_LOG_EMIT(__VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#if ES_LOG_LEVEL >= ES_LOG_WARN
+#define LOG_WARN(...) ES_LOG_EMIT(__VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if ES_LOG_LEVEL >= ES_LOG_INFO
+#define LOG_INFO(...) ES_LOG_EMIT(__VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if ES_LOG_LEVEL >= ES_LOG_DEBUG
+#define LOG_DEBUG(...) ES_LOG_EMIT(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+
+#endif /* ES_LOG_CHANNEL */
+
+#endif /* ES_LOG_H */
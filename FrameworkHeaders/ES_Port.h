@@ -9,6 +9,9 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 11:30 mp      added _HW_GetTimeStamp for event time stamps
+ 10/18/26 10:05 mp      no hardware headers or interrupt control in HOST_TEST
+                        builds, so that module harnesses can run on a PC
  10/26/17 18:39 jec     moves definition of ALL_BITS to here
  10/14/15 21:50 jec     added prototype for ES_Timer_GetTime
  01/18/15 13:24 jec     clean up and adapt to use TI driver lib functions
@@ -22,8 +25,11 @@
 #ifndef ES_PORT_H
 #define ES_PORT_H
 
-// pull in the hardware header files that we need
+// pull in the hardware header files that we need. Module test harnesses
+// built for the host (HOST_TEST) do without them
+#ifndef HOST_TEST
 #include <xc.h>
+#endif
 
 #include <stdio.h>
 #include <stdint.h>
@@ -75,7 +81,7 @@ extern  uint8_t _INTCON_temp;
 // disabling interrupts. 
 // NOTE: This means that critical regions can not be nested
 // I don't think that this should be a serious limitation for the framework
-#ifdef POST_FROM_INTS
+#if defined(POST_FROM_INTS) && !defined(HOST_TEST)
 #define EnterCritical()__builtin_disable_interrupts()
 #define ExitCritical() __builtin_enable_interrupts()
 #else
@@ -83,6 +89,23 @@ extern  uint8_t _INTCON_temp;
 #define ExitCritical()
 #endif
 
+// Free running time base for event time stamps. On the PIC32 this is the
+// core timer, which counts at 20MHz. Host builds use a monotonic clock scaled
+// to the same rate so that the statistics read the same.
+#define ES_TIMESTAMP_TICKS_PER_US 20
+#ifndef HOST_TEST
+#define _HW_GetTimeStamp() ((uint32_t)_CP0_GET_COUNT())
+#else
+#include <time.h>
+static inline uint32_t _HW_GetTimeStamp(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return (uint32_t)((Now.tv_sec * 1000000000ULL + Now.tv_nsec) /
+      (1000 / ES_TIMESTAMP_TICKS_PER_US));
+}
+#endif
+
 /* Rate constants for programming the SysTick Period to generate tick interrupts.
    These assume that we are using the M4K core timer running at 20MHz. Even
    thought the processor clock is 40MHz the core timer increments every other 
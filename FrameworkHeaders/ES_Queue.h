@@ -9,6 +9,7 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 21:00 mp       added ES_PeekQueue and ES_GetQueueSize prototypes
  08/05/13 15:19 jec      modifications to suit new portable type definitions
  01/15/12 09:36 jec      converted to use new types from ES_Types.h
  10/17/11 07:49 jec      new header to match the rest of the framework
@@ -28,6 +29,9 @@ bool ES_EnQueueLIFO(ES_Event_t *pBlock, ES_Event_t Event2Add);
 uint8_t ES_DeQueue(ES_Event_t *pBlock, ES_Event_t *pReturnEvent);
 //void EF_FlushQueue( unsigned char * pBlock );
 bool ES_IsQueueEmpty(ES_Event_t *pBlock);
+uint8_t ES_PurgeTimeouts(ES_Event_t *pBlock, uint16_t TimerMask);
+uint8_t ES_PeekQueue(ES_Event_t *pBlock, ES_Event_t *pDest, uint8_t MaxCount);
+uint8_t ES_GetQueueSize(ES_Event_t *pBlock);
 
 #endif /*ES_Queue_H */
 
@@ -0,0 +1,43 @@
+/****************************************************************************
+ Module
+         ES_ShortTimer.h
+
+ Revision
+         2.0.0
+
+ Description
+         Header File for the short (micro-second) timer module
+
+ Notes
+         The channels and the services that they post to are set up in
+         ES_Configure.h
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/19/26 00:05 mp   added the ES_ShortTimer_CheckExpired event checker
+ 10/18/26 10:05 mp   re-written for the multiplexed PIC32 version
+ 10/11/15 10:30 jec  Began Coding
+****************************************************************************/
+
+#ifndef ES_ShortTimer_H
+#define ES_ShortTimer_H
+
+#include "ES_Types.h"
+#include "ES_Timers.h"
+
+// the longest time that may be requested on a channel (100 seconds)
+#define SHORT_TIMER_MAX_US 100000000UL
+
+void ES_ShortTimer_Init(void);
+ES_TimerReturn_t ES_ShortTimer_Start(uint8_t Num, uint32_t Microseconds);
+ES_TimerReturn_t ES_ShortTimer_Stop(uint8_t Num);
+ES_TimerReturn_t ES_ShortTimer_IsActive(uint8_t Num);
+bool ES_ShortTimer_CheckExpired(void);
+
+#ifdef HOST_TEST
+void ES_ShortTimer_SimAdvance(uint32_t Microseconds);
+#endif
+
+#endif   /* ES_ShortTimer_H */
+/*------------------------------ End of file ------------------------------*/
@@ -14,6 +14,10 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/18/26 21:00 mp   added ES_Timer_GetActive & ES_Timer_GetRemaining
+ 10/18/26 14:20 mp   added ES_Timer_StopGroup & ES_Timer_RestartGroup
+ 10/18/26 13:10 mp   added ES_Timer_NextInSet for walking ES_TIMEOUT_SET masks
+ 10/18/26 09:15 mp   ES_Timer_Tick_Resp now takes the number of elapsed ticks
  10/13/15 20:48 jec  removed prototype for IsTimerActive, I had removed the code
                      a couple of years ago
  08/13/13 12:03 jec  added prototype for ES_Timer_Tick_Resp as part of
@@ -42,13 +46,21 @@ typedef enum
   ES_Timer_NOT_ACTIVE = 0
 }ES_TimerReturn_t;
 
+// the highest numbered timer in a (non-zero) ES_TIMEOUT_SET mask. Services
+// walk the mask with this, clearing each bit as it is handled
+#define ES_Timer_NextInSet(Mask) ((uint8_t)(31 - __builtin_clz((uint32_t)(Mask))))
+
 void ES_Timer_Init(TimerRate_t Rate);
-void ES_Timer_Tick_Resp(void);
+void ES_Timer_Tick_Resp(uint16_t ElapsedTicks);
 ES_TimerReturn_t ES_Timer_InitTimer(uint8_t Num, uint16_t NewTime);
 ES_TimerReturn_t ES_Timer_SetTimer(uint8_t Num, uint16_t NewTime);
 ES_TimerReturn_t ES_Timer_StartTimer(uint8_t Num);
 ES_TimerReturn_t ES_Timer_StopTimer(uint8_t Num);
+ES_TimerReturn_t ES_Timer_StopGroup(uint8_t OwnerService, uint16_t Mask);
+ES_TimerReturn_t ES_Timer_RestartGroup(uint8_t OwnerService, uint16_t Mask);
 uint16_t ES_Timer_GetTime(void);
+uint16_t ES_Timer_GetActive(void);
+uint16_t ES_Timer_GetRemaining(uint8_t Num);
 
 #endif   /* ES_Timers_H */
 /*------------------------------ End of file ------------------------------*/
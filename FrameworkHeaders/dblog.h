@@ -0,0 +1,53 @@
+/****************************************************************************
+ Module
+   dblog.h
+
+ Description
+   Deferred formatting log. DB_LOG takes a DB_printf style format string and
+   up to DB_LOG_MAX_ARGS integer arguments, but only the address of the
+   format string and the raw argument words are written to the terminal.
+   The text is put together on the host by Tools/dblog_decode.py, using the
+   format strings that the linker collected in the .dblog_fmt section of the
+   ELF file.
+
+ Notes
+   Arguments are passed as 32 bit words, so %d, %x, %u and %c work as they do
+   for DB_printf. A %s argument must be a pointer to a string in flash (a
+   literal or a const table) cast to uint32_t, since the decoder looks it up
+   in the ELF file rather than in RAM.
+   Each record goes into the transmit buffer whole or not at all, so records
+   never get split up when the buffer is full.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 18:30 mp      first pass
+****************************************************************************/
+#ifndef DBLOG_H
+#define DBLOG_H
+
+#include "ES_Port.h"
+
+// a record starts with this byte. DB_printf output is plain ASCII, so it can
+// not be mistaken for the start of a record
+#define DB_LOG_SYNC       0xA5
+#define DB_LOG_MAX_ARGS   8
+// sync, argument count, 4 byte format ID, then the arguments
+#define DB_LOG_HEADER_LEN 6
+
+// the format string is placed in .dblog_fmt, the arguments are counted by
+// the size of the initialized array (the leading 0 lets the list be empty)
+#define DB_LOG(Format, ...)                                                 \
+  do {                                                                      \
+    static const char DB_LogFmt[]                                           \
+      __attribute__((section(".dblog_fmt"), used)) = Format;               \
+    const uint32_t DB_LogArgs[] = { 0, ##__VA_ARGS__ };                     \
+    _Static_assert(sizeof(DB_LogArgs) / sizeof(uint32_t) - 1 <=             \
+                   DB_LOG_MAX_ARGS, "too many DB_LOG arguments");           \
+    DB_LogWrite(DB_LogFmt, &DB_LogArgs[1],                                  \
+                sizeof(DB_LogArgs) / sizeof(uint32_t) - 1);                 \
+  } while (0)
+
+void DB_LogWrite(const char *pFormat, const uint32_t *pArgs, uint8_t NumArgs);
+
+#endif /* DBLOG_H */
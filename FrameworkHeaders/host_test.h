@@ -0,0 +1,49 @@
+/****************************************************************************
+ Module
+   host_test.h
+
+ Description
+   Helpers shared by the module test harnesses that run on the host, the
+   ones built with TEST and HOST_TEST.
+
+ Notes
+   Each harness is a program of its own, so the helpers are static inline
+   here rather than in a module to link. Include this from inside the
+   #if defined(TEST) && defined(HOST_TEST) block of the harness; it is
+   empty in any other build. Not built for the PIC32.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      first pass, Check and Seconds from the harnesses
+****************************************************************************/
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+// reports a check that failed, returns Condition so that results can be
+// ANDed together
+static inline bool Check(bool Condition, const char *pWhat)
+{
+  if (!Condition)
+  {
+    fprintf(stdout, "failed: %s\n", pWhat);
+  }
+  return Condition;
+}
+
+// a monotonic time in seconds, for timing loops
+static inline double Seconds(void)
+{
+  struct timespec Now;
+
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return Now.tv_sec + Now.tv_nsec * 1e-9;
+}
+#endif // TEST && HOST_TEST
+
+#endif /* HOST_TEST_H */
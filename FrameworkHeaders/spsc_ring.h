@@ -0,0 +1,65 @@
+/****************************************************************************
+ Module
+   spsc_ring.h
+
+ Description
+   Lock free single producer, single consumer byte ring.
+
+ Notes
+   One side (an ISR or a thread) only ever puts, the other only ever gets.
+   The caller supplies both the SPSCRing_t and the storage, whose size must
+   be a power of two. All of it can be used, there is no wasted slot.
+   Head and Tail run freely and wrap at 2^32; Head - Tail is the number of
+   bytes in the ring. Each side keeps a copy of the other side's index and
+   only reads the shared one again when the copy says the ring is full
+   (producer) or empty (consumer).
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 20:00 mp      first pass
+****************************************************************************/
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __XC32
+// the PIC32MX has no data cache, so there is nothing to keep apart
+#define SPSC_CACHE_LINE 4
+#else
+#define SPSC_CACHE_LINE 64
+#endif
+
+typedef struct
+{
+  // set by SPSCRing_Init, only read after that
+  uint8_t *pStorage;
+  uint32_t Mask;
+  // written by the producer
+  uint32_t Head __attribute__((aligned(SPSC_CACHE_LINE)));
+  uint32_t CachedTail;
+  // written by the consumer
+  uint32_t Tail __attribute__((aligned(SPSC_CACHE_LINE)));
+  uint32_t CachedHead;
+} __attribute__((aligned(SPSC_CACHE_LINE))) SPSCRing_t;
+
+void SPSCRing_Init(SPSCRing_t *pRing, uint8_t *pStorage, uint32_t Size);
+
+// producer side
+bool SPSCRing_Put(SPSCRing_t *pRing, uint8_t Byte);
+size_t SPSCRing_PutRange(SPSCRing_t *pRing, const uint8_t *pBytes,
+                         size_t Count);
+size_t SPSCRing_Free(SPSCRing_t *pRing);
+
+// consumer side
+bool SPSCRing_Get(SPSCRing_t *pRing, uint8_t *pByte);
+size_t SPSCRing_GetRange(SPSCRing_t *pRing, uint8_t *pBytes, size_t MaxCount);
+bool SPSCRing_IsEmpty(SPSCRing_t *pRing);
+
+// either side, the answer may be stale by the time it is used
+size_t SPSCRing_Count(const SPSCRing_t *pRing);
+
+#endif /* SPSC_RING_H */
@@ -20,20 +20,36 @@ extern "C" {
 #define clrLine() printf("\x1b[K")
     
 #define XMIT_BUFFER_SIZE 1024
+#define RECV_BUFFER_SIZE 256
     
 // map the generic functions for testing the serial port to actual functions
 // for this platform.
-#define IsNewKeyReady() (U1STAbits.URXDA)
+#define IsNewKeyReady() Terminal_IsRxData()
 #define GetNewKey Terminal_ReadByte
 //#define putch Terminal_WriteByte
-#define kbhit() (U1STAbits.URXDA)
+#define kbhit() Terminal_IsRxData()
     
 void Terminal_HWInit(void);
 uint8_t Terminal_ReadByte(void);
 void Terminal_WriteByte(uint8_t txByte);
+void Terminal_Write(const uint8_t *pBytes, size_t Count);
+bool Terminal_WriteRecord(const uint8_t *pBytes, size_t Count);
+uint32_t Terminal_GetTxOverruns(void);
 bool Terminal_IsRxData(void);
+uint32_t Terminal_GetRxOverruns(void);
+void Terminal_SetLineMode(bool NewLineMode);
+bool Terminal_IsLineMode(void);
+bool Terminal_GetNewLine(uint16_t *pHandle);
+const char *Terminal_GetLine(uint16_t Handle);
 void Terminal_MoveBuffer2UART( void );
 
+#ifdef HOST_TEST
+size_t Terminal_SimDrain(uint8_t *pBytes, size_t MaxBytes);
+bool Terminal_SimTxInterrupt(void);
+void Terminal_SimRxInterrupt(const uint8_t *pBytes, size_t Count,
+    bool Overrun);
+#endif
+
 #ifdef __XC16__  // DEPRICATED, USE FOR xc16 of xc32 v1.34 or lower
 int write(int handle, void *buffer, unsigned int len);
 #endif
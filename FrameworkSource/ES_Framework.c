@@ -8,6 +8,13 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 21:00 mp      added ES_PeekServiceQueue and ES_GetReady so that the
+                        shell can show the queues without owning them
+ 10/18/26 16:10 mp      the UART TX interrupt now empties the terminal buffer,
+                        so the idle loop only checks for user events
+ 10/18/26 14:20 mp      added ES_PurgeTimeoutEvents for the timer groups
+ 10/18/26 11:30 mp      stamp events as they are posted and keep post to
+                        dispatch latency histograms (ES_EVENT_TIMESTAMPS)
  08/21/17 13:18 jec     added conditional call to initialize the port lines
                         for the hardware debugging of the framework/apps
  12/19/16 20:18 jec      changed includes to accomodate the change to a fixed
@@ -42,8 +49,10 @@
 #include "EventCheckWrapper.h"
 
 #include "ES_Port.h"          // needed for definition of REENTRANT
+#include "dbprintf.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #ifndef ES_CONFIGURE_H
 #error "ES_Configure.h was not included"
@@ -58,6 +67,11 @@ typedef RunFunc_t   *pRunFunc;
 
 #define NULL_INIT_FUNC ((pInitFunc)0)
 
+// The latency histograms use log2 buckets in micro-seconds. Bucket 0 counts
+// dispatches in under 1us, bucket n counts [2^(n-1), 2^n)us and the last
+// bucket also collects everything longer than that
+#define LATENCY_BUCKETS 16
+
 typedef struct
 {
   InitFunc_t *InitFunc;       // Service Initialization function
@@ -72,6 +86,10 @@ typedef struct
 
 /*---------------------------- Module Functions ---------------------------*/
 //static bool CheckSystemEvents( void );
+#ifdef ES_EVENT_TIMESTAMPS
+static void RecordLatency(uint8_t WhichService, const ES_Event_t *pThisEvent);
+static void PrintHistogram(const uint32_t *pCounts);
+#endif
 
 /*---------------------------- Module Variables ---------------------------*/
 /****************************************************************************/
@@ -237,6 +255,14 @@ static ES_QueueDesc_t const EventQueues[NUM_SERVICES] = {
 
 uint16_t Ready;
 
+#ifdef ES_EVENT_TIMESTAMPS
+/****************************************************************************/
+// post to dispatch latency statistics, kept by ES_Run
+static uint32_t ServiceLatency[NUM_SERVICES][LATENCY_BUCKETS];
+static uint32_t EventLatency[NUM_ES_EVENT_TYPES][LATENCY_BUCKETS];
+static uint32_t MaxServiceLatency[NUM_SERVICES];  // in us
+#endif
+
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
  Function
@@ -291,7 +317,7 @@ ES_Return_t ES_Initialize(TimerRate_t NewRate)
    to find one with a non-empty queue and then executes the
    service to process the event in its queue.
    while all the queues are empty, it searches for system generated or
-   user generated events or moves bytes from buffer to UART.
+   user generated events.
  Notes
    this function only returns in case of an error
  Author
@@ -314,6 +340,9 @@ ES_Return_t ES_Run(void)
       {
         Ready &= BitNum2ClrMask[HighestPrior]; // mark queue as now empty
       }
+#ifdef ES_EVENT_TIMESTAMPS
+      RecordLatency(HighestPrior, &ThisEvent);
+#endif
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
       _HW_DebugSetLine1();
 #endif
@@ -331,10 +360,7 @@ ES_Return_t ES_Run(void)
     _HW_DebugSetLine2();
 #endif
     // all the queues are empty, so look for new user detected events
-    if (!ES_CheckUserEvents()) // no new user events
-    {
-      Terminal_MoveBuffer2UART(); // try moving bytes, if available, to UART
-    }
+    ES_CheckUserEvents();
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
     _HW_DebugClearLine2();
 #endif
@@ -358,6 +384,9 @@ ES_Return_t ES_Run(void)
 bool ES_PostAll(ES_Event_t ThisEvent)
 {
   uint8_t i;
+#ifdef ES_EVENT_TIMESTAMPS
+  ThisEvent.TimeStamp = _HW_GetTimeStamp();
+#endif
   // loop through the list executing the post functions
   for (i = 0; i < ARRAY_SIZE(EventQueues); i++)
   {
@@ -397,6 +426,9 @@ bool ES_PostAll(ES_Event_t ThisEvent)
 ****************************************************************************/
 bool ES_PostToService(uint8_t WhichService, ES_Event_t TheEvent)
 {
+#ifdef ES_EVENT_TIMESTAMPS
+  TheEvent.TimeStamp = _HW_GetTimeStamp();
+#endif
   if ((WhichService < ARRAY_SIZE(EventQueues)) &&
       (ES_EnQueueFIFO(EventQueues[WhichService].pMem, TheEvent) ==
         true))
@@ -421,7 +453,8 @@ bool ES_PostToService(uint8_t WhichService, ES_Event_t TheEvent)
  Description
    Posts, using LIFO strategy, to one of the services' queues
  Notes
-   used by the Defer/Recall event capability
+   used by the Defer/Recall event capability. The time stamp is left alone
+   so that a recalled event reports the time since its original post
  Author
    J. Edward Carryer, 11/02/13
 ****************************************************************************/
@@ -440,9 +473,208 @@ bool ES_PostToServiceLIFO(uint8_t WhichService, ES_Event_t TheEvent)
   }
 }
 
+/****************************************************************************
+ Function
+   ES_PurgeTimeoutEvents
+ Parameters
+   uint8_t : Which service's queue to purge (index into ServDescList)
+   uint16_t : mask of the timers whose pending timeouts should be dropped
+ Returns
+   boolean : False if there is no such service
+ Description
+   removes the not yet handled timeouts from the timers in the mask from
+   one of the services' queues
+ Notes
+   used by the timer library when a group of timers is stopped or restarted
+ Author
+   M. Peraza, 10/18/26 14:20
+****************************************************************************/
+bool ES_PurgeTimeoutEvents(uint8_t WhichService, uint16_t TimerMask)
+{
+  if (WhichService >= ARRAY_SIZE(EventQueues))
+  {
+    return false;
+  }
+  ES_PurgeTimeouts(EventQueues[WhichService].pMem, TimerMask);
+  EnterCritical();  // an interrupt may post between the purge and this test
+  if (ES_IsQueueEmpty(EventQueues[WhichService].pMem))
+  {
+    Ready &= BitNum2ClrMask[WhichService]; // mark queue as now empty
+  }
+  ExitCritical();
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_PeekServiceQueue
+ Parameters
+   uint8_t : Which service's queue to look at (index into ServDescList)
+   ES_Event_t * : where to copy the queued events, oldest first
+   uint8_t : the most events to copy
+   uint8_t * : set to the size of the queue
+ Returns
+   uint8_t : the number of events in the queue, 0 if there is no such service
+ Description
+   copies a service's pending events without removing them
+ Author
+   M. Peraza, 10/18/26 21:00
+****************************************************************************/
+uint8_t ES_PeekServiceQueue(uint8_t WhichService, ES_Event_t *pDest,
+    uint8_t MaxCount, uint8_t *pQueueSize)
+{
+  if (WhichService >= ARRAY_SIZE(EventQueues))
+  {
+    *pQueueSize = 0;
+    return 0;
+  }
+  *pQueueSize = ES_GetQueueSize(EventQueues[WhichService].pMem);
+  return ES_PeekQueue(EventQueues[WhichService].pMem, pDest, MaxCount);
+}
+
+/****************************************************************************
+ Function
+   ES_GetReady
+ Parameters
+   None
+ Returns
+   uint16_t : the Ready bitmap, one bit per service with a non-empty queue
+ Author
+   M. Peraza, 10/18/26 21:00
+****************************************************************************/
+uint16_t ES_GetReady(void)
+{
+  return Ready;
+}
+
+#ifdef ES_EVENT_TIMESTAMPS
+/****************************************************************************
+ Function
+   ES_PrintLatencyStats
+ Parameters
+   None
+ Returns
+   nothing
+ Description
+   prints the post to dispatch latency histograms for every service and
+   event type that has seen any traffic, one line each
+ Notes
+   each entry is printed as <bucket floor in us>:<count>. Only non-empty
+   buckets are printed to keep the output within the terminal buffer
+ Author
+   M. Peraza, 10/18/26
+****************************************************************************/
+void ES_PrintLatencyStats(void)
+{
+  uint8_t i;
+
+  DB_printf("Post to dispatch latency (us:count)\r\n");
+  for (i = 0; i < NUM_SERVICES; i++)
+  {
+    if (MaxServiceLatency[i] != 0 || ServiceLatency[i][0] != 0)
+    {
+      DB_printf("Svc %d max %u:", i, MaxServiceLatency[i]);
+      PrintHistogram(ServiceLatency[i]);
+    }
+  }
+  for (i = 0; i < NUM_ES_EVENT_TYPES; i++)
+  {
+    uint8_t Bucket;
+    for (Bucket = 0; Bucket < LATENCY_BUCKETS; Bucket++)
+    {
+      if (EventLatency[i][Bucket] != 0)
+      {
+        DB_printf("Evt %d:", i);
+        PrintHistogram(EventLatency[i]);
+        break;
+      }
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_ClearLatencyStats
+ Parameters
+   None
+ Returns
+   nothing
+ Description
+   zeroes the latency histograms and maximums
+ Author
+   M. Peraza, 10/18/26
+****************************************************************************/
+void ES_ClearLatencyStats(void)
+{
+  memset(ServiceLatency, 0, sizeof(ServiceLatency));
+  memset(EventLatency, 0, sizeof(EventLatency));
+  memset(MaxServiceLatency, 0, sizeof(MaxServiceLatency));
+}
+#endif
+
 //*********************************
 // private functions
 //*********************************
+#ifdef ES_EVENT_TIMESTAMPS
+/****************************************************************************
+ Function
+   RecordLatency
+ Parameters
+   uint8_t : the service the event was dispatched to
+   ES_Event_t * : the event being dispatched
+ Returns
+   nothing
+ Description
+   adds the time since the event was posted to the histograms for the
+   service and the event type
+ Notes
+   the unsigned subtraction takes care of the time base rolling over
+ Author
+   M. Peraza, 10/18/26
+****************************************************************************/
+static void RecordLatency(uint8_t WhichService, const ES_Event_t *pThisEvent)
+{
+  uint32_t  Latency;
+  uint8_t   Bucket = 0;
+
+  Latency = (_HW_GetTimeStamp() - pThisEvent->TimeStamp) /
+      ES_TIMESTAMP_TICKS_PER_US;
+  if (Latency != 0)
+  {
+    Bucket = 32 - __builtin_clz(Latency);
+    if (Bucket >= LATENCY_BUCKETS)
+    {
+      Bucket = LATENCY_BUCKETS - 1;
+    }
+  }
+  ServiceLatency[WhichService][Bucket]++;
+  if (Latency > MaxServiceLatency[WhichService])
+  {
+    MaxServiceLatency[WhichService] = Latency;
+  }
+  if (pThisEvent->EventType < NUM_ES_EVENT_TYPES)
+  {
+    EventLatency[pThisEvent->EventType][Bucket]++;
+  }
+}
+
+// prints the non-empty buckets of one histogram and ends the line
+static void PrintHistogram(const uint32_t *pCounts)
+{
+  uint8_t Bucket;
+
+  for (Bucket = 0; Bucket < LATENCY_BUCKETS; Bucket++)
+  {
+    if (pCounts[Bucket] != 0)
+    {
+      DB_printf(" %u:%u", (Bucket == 0) ? 0 : (1u << (Bucket - 1)),
+          pCounts[Bucket]);
+    }
+  }
+  DB_printf("\r\n");
+}
+#endif
+
 #if 0
 /****************************************************************************
  Function
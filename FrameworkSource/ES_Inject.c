@@ -0,0 +1,364 @@
+/****************************************************************************
+ Module
+   ES_Inject.c
+
+ Revision
+   1.0.0
+
+ Description
+   Incremental parser for the event injection frames described in
+   ES_Inject.h. The terminal event checker passes each received byte to
+   ES_Inject_ParseByte, which posts the event when a good frame completes.
+
+ Notes
+   Bytes are parsed in the main loop, not in the RX interrupt, because the
+   framework's post functions are not safe to call from an interrupt.
+   A frame with a bad length, CRC, service or event type is thrown away and
+   counted; the parser then looks for the next sync byte.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      the harness uses Check from host_test.h
+ 10/18/26 20:45 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Timers.h"
+#include "ES_Inject.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define CRC8_POLY 0x07
+
+/*------------------------------ Module Types -----------------------------*/
+typedef enum
+{
+  HuntingSync,
+  GettingLength,
+  GettingPayload,
+  GettingCRC
+}ParserState_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_InjectResult_t FinishFrame(uint8_t ReceivedCRC);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ParserState_t ParserState = HuntingSync;
+// the length byte followed by the payload, which is what the CRC covers
+static uint8_t Frame[1 + INJECT_PAYLOAD_LEN];
+static uint8_t FrameIndex;
+static uint16_t LastByteTime;
+static uint32_t FrameCount;
+static uint32_t ErrorCount;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_Inject_ParseByte
+
+ Parameters
+   uint8_t NewByte : the next byte from the terminal
+
+ Returns
+   ES_InjectResult_t : INJECT_NOT_MINE if the byte is not part of a frame,
+   INJECT_POSTED if it completed a good frame, INJECT_IN_FRAME otherwise
+
+ Description
+   Runs the frame parser on one byte.
+ Author
+   M. Peraza, 10/18/26 20:45
+****************************************************************************/
+ES_InjectResult_t ES_Inject_ParseByte(uint8_t NewByte)
+{
+  uint16_t Now = ES_Timer_GetTime();
+
+  if ((ParserState != HuntingSync) &&
+      ((uint16_t)(Now - LastByteTime) > INJECT_GAP_MS))
+  {
+    // the rest of the last frame never came
+    ErrorCount++;
+    ParserState = HuntingSync;
+  }
+  LastByteTime = Now;
+
+  switch (ParserState)
+  {
+    case HuntingSync:
+    {
+      if (NewByte != INJECT_SYNC)
+      {
+        return INJECT_NOT_MINE;
+      }
+      ParserState = GettingLength;
+    }
+    break;
+
+    case GettingLength:
+    {
+      if (NewByte != INJECT_PAYLOAD_LEN)
+      {
+        ErrorCount++;
+        ParserState = HuntingSync;
+        break;
+      }
+      Frame[0] = NewByte;
+      FrameIndex = 1;
+      ParserState = GettingPayload;
+    }
+    break;
+
+    case GettingPayload:
+    {
+      Frame[FrameIndex++] = NewByte;
+      if (FrameIndex == sizeof(Frame))
+      {
+        ParserState = GettingCRC;
+      }
+    }
+    break;
+
+    case GettingCRC:
+    {
+      ParserState = HuntingSync;
+      return FinishFrame(NewByte);
+    }
+    break;
+  }
+  return INJECT_IN_FRAME;
+}
+
+/****************************************************************************
+ Function
+   ES_Inject_GetFrameCount
+
+ Parameters
+   None
+
+ Returns
+   uint32_t : number of good frames whose events were posted
+
+ Author
+   M. Peraza, 10/18/26 20:45
+****************************************************************************/
+uint32_t ES_Inject_GetFrameCount(void)
+{
+  return FrameCount;
+}
+
+/****************************************************************************
+ Function
+   ES_Inject_GetErrorCount
+
+ Parameters
+   None
+
+ Returns
+   uint32_t : number of frames thrown away, for a bad length, CRC, service
+   or event type, for stopping part way, or because the post failed
+
+ Author
+   M. Peraza, 10/18/26 20:45
+****************************************************************************/
+uint32_t ES_Inject_GetErrorCount(void)
+{
+  return ErrorCount;
+}
+
+/****************************************************************************
+ Function
+   ES_Inject_CRC8
+
+ Parameters
+   const uint8_t *pBytes : the bytes to check
+   uint8_t Count : how many
+
+ Returns
+   uint8_t : the CRC-8 (polynomial 0x07, initial value 0) of the bytes
+
+ Author
+   M. Peraza, 10/18/26 20:45
+****************************************************************************/
+uint8_t ES_Inject_CRC8(const uint8_t *pBytes, uint8_t Count)
+{
+  uint8_t CRC = 0;
+  uint8_t Bit;
+
+  while (Count-- > 0)
+  {
+    CRC ^= *pBytes++;
+    for (Bit = 0; Bit < 8; Bit++)
+    {
+      CRC = (CRC & 0x80) ? (uint8_t)((CRC << 1) ^ CRC8_POLY) :
+                           (uint8_t)(CRC << 1);
+    }
+  }
+  return CRC;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+// checks a complete frame and posts its event
+static ES_InjectResult_t FinishFrame(uint8_t ReceivedCRC)
+{
+  ES_Event_t ThisEvent;
+  uint8_t Service = Frame[1];
+  uint16_t EventType = Frame[2] | ((uint16_t)Frame[3] << 8);
+  bool Posted;
+
+  if ((ES_Inject_CRC8(Frame, sizeof(Frame)) != ReceivedCRC) ||
+      (EventType >= NUM_ES_EVENT_TYPES))
+  {
+    ErrorCount++;
+    return INJECT_IN_FRAME;
+  }
+  ThisEvent.EventType = (ES_EventType_t)EventType;
+  ThisEvent.EventParam = Frame[4] | ((uint16_t)Frame[5] << 8);
+  if (Service == INJECT_BROADCAST)
+  {
+    Posted = ES_PostAll(ThisEvent);
+  }
+  else
+  {
+    // an unknown service is refused here too
+    Posted = ES_PostToService(Service, ThisEvent);
+  }
+  if (!Posted)
+  {
+    ErrorCount++;
+    return INJECT_IN_FRAME;
+  }
+  FrameCount++;
+  return INJECT_POSTED;
+}
+
+/***************************************************************************
+ module test harness, stands in for the timer and the post functions
+ gcc -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     FrameworkSource/ES_Inject.c -o inject_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include "host_test.h"
+
+static uint16_t SimTime;
+static ES_Event_t LastEvent;
+static uint8_t LastService;
+static unsigned NumPosts;
+
+uint16_t ES_Timer_GetTime(void)
+{
+  return SimTime;
+}
+
+bool ES_PostToService(uint8_t WhichService, ES_Event_t TheEvent)
+{
+  if (WhichService >= 8)
+  {
+    return false;
+  }
+  LastService = WhichService;
+  LastEvent = TheEvent;
+  NumPosts++;
+  return true;
+}
+
+bool ES_PostAll(ES_Event_t TheEvent)
+{
+  LastService = INJECT_BROADCAST;
+  LastEvent = TheEvent;
+  NumPosts++;
+  return true;
+}
+
+// builds a frame, and returns its length
+static uint8_t MakeFrame(uint8_t *pFrame, uint8_t Service, uint16_t Type,
+                         uint16_t Param)
+{
+  pFrame[0] = INJECT_SYNC;
+  pFrame[1] = INJECT_PAYLOAD_LEN;
+  pFrame[2] = Service;
+  pFrame[3] = (uint8_t)Type;
+  pFrame[4] = (uint8_t)(Type >> 8);
+  pFrame[5] = (uint8_t)Param;
+  pFrame[6] = (uint8_t)(Param >> 8);
+  pFrame[7] = ES_Inject_CRC8(&pFrame[1], 6);
+  return 8;
+}
+
+// feeds bytes to the parser, returning how many were left as keystrokes
+static unsigned Feed(const uint8_t *pBytes, uint8_t Count)
+{
+  unsigned Keys = 0;
+  while (Count-- > 0)
+  {
+    if (ES_Inject_ParseByte(*pBytes++) == INJECT_NOT_MINE)
+    {
+      Keys++;
+    }
+  }
+  return Keys;
+}
+
+int main(void)
+{
+  static const uint8_t CheckString[] = "123456789";
+  uint8_t Bytes[32];
+  uint8_t Length;
+  bool Passed = true;
+  uint32_t i;
+
+  // the standard check value for this CRC
+  Passed &= Check(ES_Inject_CRC8(CheckString, 9) == 0xF4, "CRC check value");
+
+  // keys either side of a frame are left alone
+  Bytes[0] = 'a';
+  Length = MakeFrame(&Bytes[1], 3, ES_Touch, 0x1234);
+  Bytes[Length + 1] = 'b';
+  Passed &= Check((Feed(Bytes, Length + 2) == 2) && (NumPosts == 1) &&
+                  (LastService == 3) && (LastEvent.EventType == ES_Touch) &&
+                  (LastEvent.EventParam == 0x1234), "frame between keys");
+
+  // broadcast
+  Length = MakeFrame(Bytes, INJECT_BROADCAST, ES_GAME, 7);
+  Feed(Bytes, Length);
+  Passed &= Check((LastService == INJECT_BROADCAST) &&
+                  (LastEvent.EventType == ES_GAME), "broadcast");
+
+  // a corrupted frame is counted and nothing is posted
+  NumPosts = 0;
+  Length = MakeFrame(Bytes, 2, ES_Shake, 1);
+  Bytes[5] ^= 0x40;
+  Passed &= Check((Feed(Bytes, Length) == 0) && (NumPosts == 0) &&
+                  (ES_Inject_GetErrorCount() == 1), "bad CRC");
+
+  // so are an unknown event type and an unknown service
+  Length = MakeFrame(Bytes, 2, NUM_ES_EVENT_TYPES, 1);
+  Feed(Bytes, Length);
+  Length = MakeFrame(Bytes, 9, ES_Shake, 1);
+  Feed(Bytes, Length);
+  Passed &= Check((NumPosts == 0) && (ES_Inject_GetErrorCount() == 3),
+                  "bad type and service");
+
+  // a frame that stops part way does not swallow the keys after the gap
+  Length = MakeFrame(Bytes, 2, ES_Shake, 1);
+  Feed(Bytes, 4);
+  SimTime += INJECT_GAP_MS + 1;
+  Passed &= Check((Feed((const uint8_t *)"xy", 2) == 2) &&
+                  (ES_Inject_GetErrorCount() == 4), "abandoned frame");
+
+  // a long run of frames, one byte at a time
+  for (i = 0; i < 100000; i++)
+  {
+    Length = MakeFrame(Bytes, i % 8, i % NUM_ES_EVENT_TYPES, (uint16_t)i);
+    Feed(Bytes, Length);
+  }
+  Passed &= Check((ES_Inject_GetFrameCount() == 100002) &&
+                  (ES_Inject_GetErrorCount() == 4), "long run");
+
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,180 @@
+/****************************************************************************
+ Module
+   ES_Log.c
+
+ Revision
+   1.0.0
+
+ Description
+   Rate limiter for the ES_Log.h macros. Each channel has a token bucket
+   that holds up to ES_LOG_BURST messages and refills at ES_LOG_RATE
+   messages per second, measured with ES_Timer_GetTime.
+
+ Notes
+   The bucket is kept as a debt in thousandths of a message rather than as a
+   count of tokens, so that an all zero bucket is a full one and nothing
+   needs to be initialized. A channel that has been quiet for longer than
+   the ES_Timer_GetTime wrap (65.5s at 1ms/tick) may see less refill than it
+   is owed, which only makes the limit stricter for one message.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      the harness uses Check from host_test.h
+ 10/18/26 19:15 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#if defined(TEST) && defined(HOST_TEST)
+// the harness logs on channel 0 at warning level
+#define ES_LOG_CHANNEL 0
+#define ES_LOG_LEVEL   ES_LOG_WARN
+#endif
+#include "ES_Port.h"
+#include "ES_Log.h"
+#include "host_test.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// one message in the units used for the debt
+#define MESSAGE_COST 1000u
+
+/*------------------------------ Module Types -----------------------------*/
+typedef struct
+{
+  uint32_t Debt;        // thousandths of a message not yet paid back
+  uint16_t LastTime;    // ES_Timer_GetTime() when Debt was last updated
+  uint16_t Dropped;     // messages refused since the last one allowed
+}LogBucket_t;
+
+/*---------------------------- Module Variables ---------------------------*/
+static LogBucket_t Buckets[NUM_LOG_CHANNELS];
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_Log_Allow
+
+ Parameters
+   uint8_t Channel : the LOG_CH_xxx channel of the caller
+
+ Returns
+   bool : true if the message should be printed
+
+ Description
+   Takes a message from the channel's bucket if there is one. When messages
+   have been refused since the last one that was allowed, prints how many
+   before returning true.
+ Notes
+   Used by the ES_Log.h macros, not normally called directly
+ Author
+   M. Peraza, 10/18/26 19:15
+****************************************************************************/
+bool ES_Log_Allow(uint8_t Channel)
+{
+  LogBucket_t *pBucket;
+  uint16_t Now;
+  uint32_t Repaid;
+
+  if (Channel >= NUM_LOG_CHANNELS)
+  {
+    return false;
+  }
+  pBucket = &Buckets[Channel];
+  Now = ES_Timer_GetTime();
+  // ES_LOG_RATE messages per second is ES_LOG_RATE thousandths per ms
+  Repaid = (uint16_t)(Now - pBucket->LastTime) * (uint32_t)ES_LOG_RATE;
+  pBucket->LastTime = Now;
+  pBucket->Debt = (Repaid >= pBucket->Debt) ? 0 : pBucket->Debt - Repaid;
+
+  if (pBucket->Debt + MESSAGE_COST > ES_LOG_BURST * MESSAGE_COST)
+  {
+    if (pBucket->Dropped < UINT16_MAX)
+    {
+      pBucket->Dropped++;
+    }
+    return false;
+  }
+  pBucket->Debt += MESSAGE_COST;
+  if (pBucket->Dropped != 0)
+  {
+    DB_printf("(%u log messages dropped)\r\n", pBucket->Dropped);
+    pBucket->Dropped = 0;
+  }
+  return true;
+}
+
+/***************************************************************************
+ module test harness, stands in for the timer and for DB_printf
+ gcc -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     FrameworkSource/ES_Log.c -o log_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include <string.h>
+
+static uint16_t SimTime;
+static unsigned NumPrinted;
+static char LastPrinted[64];
+
+uint16_t ES_Timer_GetTime(void)
+{
+  return SimTime;
+}
+
+void DB_printf(const char *Format, ...)
+{
+  NumPrinted++;
+  strncpy(LastPrinted, Format, sizeof(LastPrinted) - 1);
+}
+
+int main(void)
+{
+  bool Passed = true;
+  unsigned Evaluated = 0;
+  unsigned i;
+
+  // below the level: no call and no argument evaluation
+  LOG_INFO("info %u\n", Evaluated++);
+  LOG_DEBUG("debug %u\n", Evaluated++);
+  Passed &= Check((NumPrinted == 0) && (Evaluated == 0), "levels compiled out");
+
+  // a burst goes through, then the bucket is empty
+  SimTime = 1000;
+  for (i = 0; i < ES_LOG_BURST + 5; i++)
+  {
+    LOG_WARN("warn %u\n", i);
+  }
+  Passed &= Check(NumPrinted == ES_LOG_BURST, "burst");
+
+  // it refills at ES_LOG_RATE per second, and reports what was dropped
+  SimTime += 1000 / ES_LOG_RATE;
+  NumPrinted = 0;
+  LOG_ERROR("error\n");
+  LOG_ERROR("error\n");
+  Passed &= Check((NumPrinted == 2) && (strcmp(LastPrinted, "error\n") == 0),
+                  "one message refilled, drop report printed");
+
+  // a long quiet spell refills the burst and no more
+  SimTime += 60000;
+  NumPrinted = 0;
+  for (i = 0; i < ES_LOG_BURST; i++)
+  {
+    LOG_WARN("warn %u\n", i);
+  }
+  Passed &= Check(NumPrinted == ES_LOG_BURST + 1, "refilled burst, one report");
+
+  // a steady stream at the rate never drops, across the timer wrap
+  NumPrinted = 0;
+  SimTime += 60000;
+  for (i = 0; i < 1000; i++)
+  {
+    SimTime += 1000 / ES_LOG_RATE;
+    LOG_WARN("steady\n");
+  }
+  Passed &= Check(NumPrinted == 1000, "steady stream");
+
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
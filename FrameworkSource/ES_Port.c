@@ -13,6 +13,8 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 09:20 mp      process all pending ticks with one call to
+                        ES_Timer_Tick_Resp
  08/06/21 15:43 jec     no changes just a test of using GIT from within MPLABX
  08/06/21 13:04 jec     cleaned things up in preparation for the 2021 AY
  10/05/20 18:52 ram     started work on port to PIC32MX170F256B
@@ -307,13 +309,20 @@ uint16_t _HW_GetTickCount(void)
 ****************************************************************************/
 bool _HW_Process_Pending_Ints(void)
 {
+  uint8_t TicksToProcess;
+
   // in the case where there was a long delay in getting to this function,
-  // multiple interrupts may have occurred (TickCount > 1), so process them all
-  while (TickCount > 0)
+  // multiple interrupts may have occurred (TickCount > 1), so grab them all
+  // at once and let the timer module catch up in a single pass
+  if (TickCount > 0)
   {
+    // the ISR also modifies TickCount, so grab & clear it atomically
+    EnterCritical();
+    TicksToProcess = TickCount;
+    TickCount = 0;
+    ExitCritical();
     /* call the framework tick response to actually run the timers */
-    ES_Timer_Tick_Resp();
-    TickCount--;
+    ES_Timer_Tick_Resp(TicksToProcess);
   }
   return true;  // always return true to allow loop test in ES_Run to proceed
 }
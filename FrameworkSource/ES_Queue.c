@@ -9,6 +9,8 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 21:00 mp       added ES_PeekQueue and ES_GetQueueSize for the shell
+ 10/18/26 14:20 mp       added ES_PurgeTimeouts to drop stale timer events
  01/15/12 09:34 jec      converted to use the new C99 types from types.h
  08/09/11 18:16 jec      started coding
 *****************************************************************************/
@@ -227,6 +229,109 @@ bool ES_IsQueueEmpty(ES_Event_t *pBlock)
   return pThisQueue->NumEntries == 0;
 }
 
+/****************************************************************************
+ Function
+   ES_PurgeTimeouts
+ Parameters
+   ES_Event_t * pBlock : pointer to the block of memory in use as the Queue
+   uint16_t TimerMask : the timers whose timeouts are no longer wanted
+ Returns
+   The number of entries remaining in the Queue
+ Description
+   removes any ES_TIMEOUT events from the timers in TimerMask and clears
+   those timers from any ES_TIMEOUT_SET events, dropping a set that ends up
+   empty. The remaining events keep their order.
+ Notes
+   the queue is compacted in place, toward the extraction point
+ Author
+   M. Peraza, 10/18/26 14:20
+****************************************************************************/
+uint8_t ES_PurgeTimeouts(ES_Event_t *pBlock, uint16_t TimerMask)
+{
+  pQueue_t    pThisQueue;
+  ES_Event_t  ThisEvent;
+  uint8_t     i;
+  uint8_t     NumKept = 0;
+
+  pThisQueue = (pQueue_t)pBlock;
+  EnterCritical();  // save interrupt state, turn ints off
+  for (i = 0; i < pThisQueue->NumEntries; i++)
+  {
+    ThisEvent = pBlock[1 + ((pThisQueue->CurrentIndex + i)
+        % pThisQueue->QueueSize)];
+    if ((ThisEvent.EventType == ES_TIMEOUT) &&
+        (ThisEvent.EventParam < 16) &&
+        (((1u << ThisEvent.EventParam) & TimerMask) != 0))
+    {
+      continue;   // a timeout from one of the purged timers, drop it
+    }
+    if (ThisEvent.EventType == ES_TIMEOUT_SET)
+    {
+      ThisEvent.EventParam &= ~TimerMask;
+      if (ThisEvent.EventParam == 0)
+      {
+        continue; // nothing left in this set
+      }
+    }
+    pBlock[1 + ((pThisQueue->CurrentIndex + NumKept)
+        % pThisQueue->QueueSize)] = ThisEvent;
+    NumKept++;
+  }
+  pThisQueue->NumEntries = NumKept;
+  ExitCritical();    // restore saved interrupt state
+  return NumKept;
+}
+
+/****************************************************************************
+ Function
+   ES_PeekQueue
+ Parameters
+   ES_Event_t * pBlock : pointer to the block of memory in use as the Queue
+   ES_Event_t * pDest : where to copy the entries
+   uint8_t MaxCount : the most entries to copy
+ Returns
+   The number of entries in the Queue, which may be more than were copied
+ Description
+   copies up to MaxCount entries, oldest first, without removing them
+ Notes
+   for inspection only; the copy is taken with interrupts off so that it
+   is consistent, but it may be out of date as soon as it is returned
+ Author
+   M. Peraza, 10/18/26 21:00
+****************************************************************************/
+uint8_t ES_PeekQueue(ES_Event_t *pBlock, ES_Event_t *pDest, uint8_t MaxCount)
+{
+  pQueue_t  pThisQueue;
+  uint8_t   NumEntries;
+  uint8_t   i;
+
+  pThisQueue = (pQueue_t)pBlock;
+  EnterCritical();  // save interrupt state, turn ints off
+  NumEntries = pThisQueue->NumEntries;
+  for (i = 0; (i < NumEntries) && (i < MaxCount); i++)
+  {
+    pDest[i] = pBlock[1 + ((pThisQueue->CurrentIndex + i)
+        % pThisQueue->QueueSize)];
+  }
+  ExitCritical();    // restore saved interrupt state
+  return NumEntries;
+}
+
+/****************************************************************************
+ Function
+   ES_GetQueueSize
+ Parameters
+   ES_Event_t * pBlock : pointer to the block of memory in use as the Queue
+ Returns
+   The number of entries the Queue can hold
+ Author
+   M. Peraza, 10/18/26 21:00
+****************************************************************************/
+uint8_t ES_GetQueueSize(ES_Event_t *pBlock)
+{
+  return ((pQueue_t)pBlock)->QueueSize;
+}
+
 #if 0
 /****************************************************************************
  Function
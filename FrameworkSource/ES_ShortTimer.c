@@ -4,184 +4,663 @@
    ES_ShortTimer.c
 
  Revision
-   1.0.1
+   2.0.0
 
  Description
    This is a library to provide for the creation of short time-outs
    (shorter than the resolution of the ES_Timer library).
 
  Notes
-   This module uses the Tiva Peripheral Driver Library functions and
-   the ability that it provides to 'hook' a function into an interrupt
-   response routine without modifying the vector table directly.
-   Uses timers A & B on 16/32 bit Timer Module 5
+   A single hardware timer (Timer4/5 in 32-bit mode) is multiplexed across
+   NUM_SHORT_TIMERS virtual one-shot channels. The active channels are kept in
+   a list sorted by deadline, and the hardware period is always programmed to
+   reach the earliest deadline. When a channel expires the Timer5 ISR only
+   sets its bit in ExpiredFlags; the event checker ES_ShortTimer_CheckExpired
+   (in EVENT_CHECK_LIST) then posts ES_SHORT_TIMEOUT to the response function
+   for that channel (set in ES_Configure.h) with the channel number in
+   EventParam. The post functions are not safe to call from an ISR, since
+   ES_Run updates its Ready flags without masking interrupts.
+   The counter is never stopped or cleared, so that no ticks are lost when
+   it is re-armed: the period register is moved ahead of the count instead.
+   Times are specified in micro-seconds. The timer runs from the 20MHz
+   peripheral clock with a 1:1 prescale, so the resolution is 50ns, though
+   deadlines closer than SHORT_TIMER_MIN_LEAD are treated as already expired.
+   Building with HOST_TEST defined replaces the Timer4/5 hardware with a
+   simulated counter (advanced with ES_ShortTimer_SimAdvance); adding TEST as
+   well includes a test harness that runs on the host.
+   The latency of a timeout is now that of the event loop, but the deadlines
+   of the other channels are unaffected.
 
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 00:55 mp      the counter runs free, re-arming moves the period
+                        ahead of the count rather than stopping and
+                        clearing it, which lost ticks on every re-arm
+ 10/19/26 00:15 mp      the harness brings its own second channel
+ 10/19/26 00:05 mp      the ISR latches expired channels and an event
+                        checker posts them, posting from IPL4 could lose
+                        a Ready bit in ES_Run
+ 10/18/26 18:30 mp      the harness needs TEST as well as HOST_TEST
+ 10/18/26 10:05 mp      re-written for the PIC32 using Timer4/5 to multiplex
+                        many virtual channels with a sorted deadline list
  10/11/15 10:30 jec     first pass
  10/11/15 18:10 jec     converted to post events to the framework
 
 ****************************************************************************/
-// the common headers for I/O, C99 types
-#include <stdio.h>
+/*----------------------------- Include Files -----------------------------*/
+#ifndef HOST_TEST
+#include <xc.h>
+#include <sys/attribs.h>    // for ISR macros
+#endif
+
+// the common headers for C99 types
 #include <stdint.h>
 #include <stdbool.h>
-#include "BITDEFS.H"
-
-// the headers to access the GPIO subsystem
-#include "inc/hw_memmap.h"
-#include "inc/hw_types.h"
-#include "inc/hw_gpio.h"
-#include "inc/hw_sysctl.h"
-#include "inc/hw_timer.h"
-#include "inc/hw_ints.h"
-
-// the headers to access the TivaWare Library
-#include "driverlib/sysctl.h"
-#include "driverlib/pin_map.h"
-#include "driverlib/gpio.h"
-#include "driverlib/timer.h"
-#include "driverlib/interrupt.h"
+
+// the framework headers
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ServiceHeaders.h"
 
 // the header to get the timing functions
 #include "ES_ShortTimer.h"
 
-// the framework headers
-#include "ES_Framework.h"
-#include "ES_Configure.h"
+/*----------------------------- Module Defines ----------------------------*/
+// Timer4/5 is clocked from the 20MHz PBCLK with a 1:1 prescale
+#define TICKS_PER_US 20
+
+// deadlines closer than this are treated as already expired, since we could
+// not get out of the ISR and back again in time to catch them.
+#define SHORT_TIMER_MIN_LEAD (2 * TICKS_PER_US)
 
-// module level functions
+// marks the end of the sorted deadline list
+#define END_OF_LIST 0xFF
 
-// define for the timer pre-scaler. this sets the resolution of the
-// timing functions
-// the current values are based on a 40mHz clock rate to give 1uS resolution
-#define PRE_1uS 40
+// priority of the Timer5 interrupt. Above the core timer tick (3) so that
+// short timeouts are not delayed by the framework tick processing
+#define SHORT_TIMER_IPL 4
 
-void ShortTimerAHandler(void);
-void ShortTimerBHandler(void);
+#if defined(TEST) && defined(HOST_TEST)
+// the harness needs two channels, so it gives channel 1, unused in
+// ES_Configure.h, a response function of its own
+bool PostTestChannel(ES_Event_t ThisEvent);
+#undef SHORT_TIMER1_RESP_FUNC
+#define SHORT_TIMER1_RESP_FUNC PostTestChannel
+#define TestPulseTimer 1
+#endif
 
-// module level variables
+/*---------------------------- Module Functions ---------------------------*/
+static void SyncTimeBase(void);
+static void CollectExpired(void);
+static void ArmForHead(void);
+static void InsertChannel(uint8_t Num);
+static void RemoveChannel(uint8_t Num);
+static void ServiceShortTimers(void);
 
-static uint8_t  Timer_A_Priority  = SHORT_TIMER_UNUSED;
-static uint8_t  Timer_B_Priority  = SHORT_TIMER_UNUSED;
+static uint32_t HW_TakeElapsed(void);
+static void HW_Arm(uint32_t Delta);
+static void HW_MaskInt(void);
+static void HW_UnmaskInt(void);
 
-//******************************
-// ES_ShortTimerInit()
-// Initialize the timer subsystem and log the services to which the timeout
-// messages will be posted
-//******************************
-void ES_ShortTimerInit(uint8_t TimeAPrio, uint8_t TimeBPrio)
+/*---------------------------- Module Variables ---------------------------*/
+static pPostFunc const ShortTimer2PostFunc[NUM_SHORT_TIMERS] =
 {
-#ifdef DEBUG
-// set up I/O lines for debugging
-  SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
-  GPIOPinTypeGPIOOutput(GPIO_PORTB_BASE, GPIO_PIN_0 | GPIO_PIN_1);
-// start with the lines low
-  GPIOPinWrite(GPIO_PORTB_BASE, GPIO_PIN_0 | GPIO_PIN_1, BIT0LO & BIT1LO);
+  SHORT_TIMER0_RESP_FUNC,
+  SHORT_TIMER1_RESP_FUNC,
+  SHORT_TIMER2_RESP_FUNC,
+  SHORT_TIMER3_RESP_FUNC
+};
+
+// absolute deadline for each channel, in timer ticks
+static uint32_t Deadline[NUM_SHORT_TIMERS];
+// links for the deadline list, sorted earliest first
+static uint8_t  NextInList[NUM_SHORT_TIMERS];
+static uint8_t  ListHead = END_OF_LIST;
+// bit set for each channel that is currently in the list
+static uint16_t ActiveFlags;
+// bit set for each channel that has expired and not been posted yet, set by
+// the ISR and taken by ES_ShortTimer_CheckExpired
+static volatile uint16_t ExpiredFlags;
+
+// the (virtual) time when the hardware count was LastCount. Current time is
+// TimeBase + the ticks counted since
+static uint32_t TimeBase;
+static uint32_t LastCount;
+// the period the counter rolls over at next, or rolled over at if the roll
+// over has not been taken yet. The same as PR4 while none is pending
+static uint32_t MatchPeriod;
+
+#ifdef HOST_TEST
+// simulated Timer4/5 registers
+static uint32_t SimCount;
+static uint32_t SimPeriod;
+static bool     SimFlag;
+static bool     SimIntEnabled;
+static uint32_t SimNow;   // total ticks simulated, for the test harness
 #endif
 
-// enable the clock to the timer module
-  SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER5);
-// configure as 2 16 bit timers
-  TimerConfigure(TIMER5_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_ONE_SHOT |
-      TIMER_CFG_B_ONE_SHOT);
-// set prescale to get 1uS resolution
-  TimerPrescaleSet(TIMER5_BASE, TIMER_BOTH, PRE_1uS);
-// log the service to which the timeout will be posted
-  Timer_A_Priority  = TimeAPrio;
-  Timer_B_Priority  = TimeBPrio;
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_ShortTimer_Init
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     Sets up Timer4/5 as a 32-bit timer running at 20MHz, starts it and
+     enables its interrupt. All channels start out inactive.
+ Notes
+     Call once, before ES_Initialize.
+ Author
+     M. Peraza, 10/18/26 10:05
+****************************************************************************/
+void ES_ShortTimer_Init(void)
+{
+  ListHead     = END_OF_LIST;
+  ActiveFlags  = 0;
+  ExpiredFlags = 0;
+  TimeBase     = 0;
+  LastCount    = 0;
+  MatchPeriod  = 0xFFFFFFFF;
+#ifndef HOST_TEST
+  // turn both halves off while we configure
+  T4CON = 0;
+  T5CON = 0;
+  // internal peripheral clock, 1:1 prescale, 32-bit mode (T4 + T5)
+  T4CONbits.TCS   = 0;
+  T4CONbits.TCKPS = 0;
+  T4CONbits.T32   = 1;
+  TMR4 = 0;
+  PR4  = 0xFFFFFFFF;
+  // in 32-bit mode the interrupt comes from the odd (Timer5) half
+  IPC5bits.T5IP = SHORT_TIMER_IPL;
+  IFS0CLR = _IFS0_T5IF_MASK;
+  IEC0SET = _IEC0_T5IE_MASK;
+  // from here on it runs free
+  T4CONbits.ON = 1;
+#else
+  SimCount      = 0;
+  SimPeriod     = 0xFFFFFFFF;
+  SimFlag       = false;
+  SimIntEnabled = true;
+#endif
 }
 
-void ES_ShortTimerStart(uint32_t Which, uint16_t TimeoutValue)
+/****************************************************************************
+ Function
+     ES_ShortTimer_Start
+ Parameters
+     uint8_t Num, the channel to start
+     uint32_t Microseconds, the time until the channel should expire
+ Returns
+     ES_Timer_ERR if the channel does not exist, has no service or the time
+     is out of range, ES_Timer_OK otherwise
+ Description
+     (re)starts a one-shot channel. If the channel was already running, its
+     old deadline is discarded.
+ Notes
+     Very short times (under SHORT_TIMER_MIN_LEAD) expire at once, and are
+     posted on the next pass of the event checkers.
+ Author
+     M. Peraza, 10/18/26 10:05
+****************************************************************************/
+ES_TimerReturn_t ES_ShortTimer_Start(uint8_t Num, uint32_t Microseconds)
 {
-  if ((Which != TIMER_A) && (Which != TIMER_B))
+  if ((Num >= NUM_SHORT_TIMERS) ||
+      (ShortTimer2PostFunc[Num] == TIMER_UNUSED) ||
+      (Microseconds == 0) || (Microseconds > SHORT_TIMER_MAX_US))
   {
-    return;
+    return ES_Timer_ERR;
   }
-  // for very short delays. just immediatly post. There is 10us of overhead
-  if (TimeoutValue < 11)
+  HW_MaskInt();
+  SyncTimeBase();
+  if (ActiveFlags & BIT0HI << Num)
   {
-    if (Which == TIMER_A)
-    {
-      ShortTimerAHandler();
-    }
-    else
+    RemoveChannel(Num);
+  }
+  Deadline[Num] = TimeBase + (Microseconds * TICKS_PER_US);
+  InsertChannel(Num);
+  CollectExpired();
+  ArmForHead();
+  HW_UnmaskInt();
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_ShortTimer_Stop
+ Parameters
+     uint8_t Num, the channel to stop
+ Returns
+     ES_Timer_ERR if the channel does not exist, ES_Timer_OK otherwise
+ Description
+     removes the channel from the deadline list so that it will not expire
+ Author
+     M. Peraza, 10/18/26 10:05
+****************************************************************************/
+ES_TimerReturn_t ES_ShortTimer_Stop(uint8_t Num)
+{
+  if (Num >= NUM_SHORT_TIMERS)
+  {
+    return ES_Timer_ERR;
+  }
+  HW_MaskInt();
+  SyncTimeBase();
+  if (ActiveFlags & BIT0HI << Num)
+  {
+    RemoveChannel(Num);
+  }
+  // a timeout latched before the stop is dropped as well
+  ExpiredFlags &= ~(BIT0HI << Num);
+  CollectExpired();
+  ArmForHead();
+  HW_UnmaskInt();
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_ShortTimer_IsActive
+ Parameters
+     uint8_t Num, the channel to test
+ Returns
+     ES_Timer_ACTIVE if the channel is running, ES_Timer_NOT_ACTIVE if not,
+     ES_Timer_ERR if the channel does not exist
+ Author
+     M. Peraza, 10/18/26 10:05
+****************************************************************************/
+ES_TimerReturn_t ES_ShortTimer_IsActive(uint8_t Num)
+{
+  if (Num >= NUM_SHORT_TIMERS)
+  {
+    return ES_Timer_ERR;
+  }
+  return (ActiveFlags & BIT0HI << Num) ? ES_Timer_ACTIVE : ES_Timer_NOT_ACTIVE;
+}
+
+/****************************************************************************
+ Function
+     ES_ShortTimer_CheckExpired
+ Parameters
+     None.
+ Returns
+     bool, true if any ES_SHORT_TIMEOUT was posted
+ Description
+     Event checker: takes the channels the ISR has marked as expired and
+     posts ES_SHORT_TIMEOUT for each, lowest channel first. A channel whose
+     post fails is left marked and tried again on the next pass.
+ Author
+     M. Peraza, 10/19/26 00:05
+****************************************************************************/
+bool ES_ShortTimer_CheckExpired(void)
+{
+  ES_Event_t ThisEvent;
+  uint16_t Expired;
+  uint16_t Failed = 0;
+  uint8_t Num;
+
+  if (ExpiredFlags == 0)
+  {
+    return false;
+  }
+  HW_MaskInt();
+  Expired = ExpiredFlags;
+  ExpiredFlags = 0;
+  HW_UnmaskInt();
+
+  ThisEvent.EventType = ES_SHORT_TIMEOUT;
+  for (Num = 0; Num < NUM_SHORT_TIMERS; Num++)
+  {
+    if (Expired & BIT0HI << Num)
     {
-      ShortTimerBHandler();
+      ThisEvent.EventParam = Num;
+      if (!ShortTimer2PostFunc[Num](ThisEvent))
+      {
+        Failed |= BIT0HI << Num;
+      }
     }
   }
-  TimerLoadSet(TIMER5_BASE, Which, TimeoutValue);
+  if (Failed != 0)
+  {
+    HW_MaskInt();
+    ExpiredFlags |= Failed;
+    HW_UnmaskInt();
+  }
+  return true;
+}
 
-  if (Which == TIMER_A) // local enable
+#ifndef HOST_TEST
+/****************************************************************************
+ Function
+     ES_ShortTimerIntHandler
+ Description
+     Timer5 interrupt (period match on the 32-bit Timer4/5 pair). Marks the
+     channels that are due as expired and re-arms for the next one.
+****************************************************************************/
+void __ISR(_TIMER_5_VECTOR, IPL4AUTO) ES_ShortTimerIntHandler(void)
+{
+  ServiceShortTimers();
+}
+#endif
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+// common response to a period match, from the ISR or the simulation
+static void ServiceShortTimers(void)
+{
+  SyncTimeBase();   // also clears the interrupt flag
+  CollectExpired();
+  ArmForHead();
+}
+
+// fold the ticks counted since the last call into TimeBase
+static void SyncTimeBase(void)
+{
+  TimeBase += HW_TakeElapsed();
+}
+
+// pull every channel that is due off the front of the list and mark it in
+// ExpiredFlags. Called from the ISR or with the interrupt masked
+static void CollectExpired(void)
+{
+  while ((ListHead != END_OF_LIST) &&
+      ((int32_t)(Deadline[ListHead] - TimeBase) <= SHORT_TIMER_MIN_LEAD))
   {
-    TimerIntEnable(TIMER5_BASE, TIMER_TIMA_TIMEOUT);
-    // NVIC Enable
-    IntEnable(INT_TIMER5A_TM4C123);
+    ExpiredFlags |= BIT0HI << ListHead;
+    ActiveFlags &= ~(BIT0HI << ListHead);
+    ListHead = NextInList[ListHead];
+  }
+}
+
+// program the hardware to interrupt at the earliest deadline, if any
+static void ArmForHead(void)
+{
+  if (ListHead != END_OF_LIST)
+  {
+    HW_Arm(Deadline[ListHead] - TimeBase);
   }
   else
   {
-    // local enable
-    TimerIntEnable(TIMER5_BASE, TIMER_TIMB_TIMEOUT);
-    // NVIC Enable
-    IntEnable(INT_TIMER5B_TM4C123);
+    HW_Arm(0);    // nothing to wait for, roll over at the end of the count
+  }
+}
+
+// insert a channel into the list, after any channels with the same deadline
+static void InsertChannel(uint8_t Num)
+{
+  uint8_t *pLink = &ListHead;
+
+  while ((*pLink != END_OF_LIST) &&
+      ((int32_t)(Deadline[*pLink] - Deadline[Num]) <= 0))
+  {
+    pLink = &NextInList[*pLink];
   }
+  NextInList[Num] = *pLink;
+  *pLink = Num;
+  ActiveFlags |= BIT0HI << Num;
+}
 
-  TimerEnable(TIMER5_BASE, Which);
+static void RemoveChannel(uint8_t Num)
+{
+  uint8_t *pLink = &ListHead;
 
-#ifdef DEBUG
-// raise I/O line to show we started
-  if (Which == TIMER_A)
+  while ((*pLink != END_OF_LIST) && (*pLink != Num))
+  {
+    pLink = &NextInList[*pLink];
+  }
+  if (*pLink == Num)
   {
-    GPIOPinWrite(GPIO_PORTB_BASE, BIT0HI, BIT0HI);
+    *pLink = NextInList[Num];
+  }
+  ActiveFlags &= ~(BIT0HI << Num);
+}
+
+#ifndef HOST_TEST
+// the ticks since the last call, including a roll over at the period match
+// that has not been serviced yet. The counter keeps running
+static uint32_t HW_TakeElapsed(void)
+{
+  uint32_t Count;
+  uint32_t Elapsed;
+
+  Count = TMR4;
+  if (IFS0bits.T5IF)
+  {
+    // rolled over at MatchPeriod, read again as it may have done so just
+    // after the first read
+    Count = TMR4;
+    Elapsed = (MatchPeriod - LastCount) + 1 + Count;
+    IFS0CLR = _IFS0_T5IF_MASK;
+    MatchPeriod = PR4;
   }
   else
   {
-    GPIOPinWrite(GPIO_PORTB_BASE, BIT1HI, BIT1HI);
+    Elapsed = Count - LastCount;
   }
-#endif
-  return;
+  LastCount = Count;
+  return Elapsed;
 }
 
-void ShortTimerAHandler(void)
+// sets the period so that the counter rolls over Delta ticks after
+// LastCount. A Delta of 0, or one past the end of the count, rolls over at
+// the end of the count and the ISR arms again from there. Delta is over
+// SHORT_TIMER_MIN_LEAD, so the count cannot reach the new period while it
+// goes in; if it reached the old one first, MatchPeriod keeps that one
+static void HW_Arm(uint32_t Delta)
 {
-  ES_Event_t ThisEvent;
+  uint32_t Period = LastCount + Delta - 1;
 
-// start by clearing the source of the interrupt
-  TimerIntClear(TIMER5_BASE, TIMER_TIMA_TIMEOUT);
-#ifdef DEBUG
-// lower I/O line to show we arrived
-  GPIOPinWrite(GPIO_PORTB_BASE, BIT0HI, BIT0LO);
-#endif
+  if ((Delta == 0) || (Period < LastCount))
+  {
+    Period = 0xFFFFFFFF;
+  }
+  PR4 = Period;
+  if (!IFS0bits.T5IF)
+  {
+    MatchPeriod = Period;
+  }
+}
 
-// post the timeout for this timer
-  ThisEvent.EventType   = ES_SHORT_TIMEOUT;
-  ThisEvent.EventParam  = TIMER_A;
-// protect against timer that was not correctly initialized
-  if (Timer_A_Priority != SHORT_TIMER_UNUSED)
+static void HW_MaskInt(void)
+{
+  IEC0CLR = _IEC0_T5IE_MASK;
+}
+
+static void HW_UnmaskInt(void)
+{
+  IEC0SET = _IEC0_T5IE_MASK;
+}
+
+#else // HOST_TEST
+static uint32_t HW_TakeElapsed(void)
+{
+  uint32_t Elapsed;
+
+  if (SimFlag)
   {
-    ES_PostToService(Timer_A_Priority, ThisEvent);
+    Elapsed = (MatchPeriod - LastCount) + 1 + SimCount;
+    SimFlag = false;
+    MatchPeriod = SimPeriod;
   }
+  else
+  {
+    Elapsed = SimCount - LastCount;
+  }
+  LastCount = SimCount;
+  return Elapsed;
 }
 
-void ShortTimerBHandler(void)
+static void HW_Arm(uint32_t Delta)
 {
-  ES_Event_t ThisEvent;
+  uint32_t Period = LastCount + Delta - 1;
 
-// start by clearing the source of the interrupt
-  TimerIntClear(TIMER5_BASE, TIMER_TIMB_TIMEOUT);
-#ifdef DEBUG
-// lower I/O line to show we arrived
-  GPIOPinWrite(GPIO_PORTB_BASE, BIT1HI, BIT1LO);
-#endif
+  if ((Delta == 0) || (Period < LastCount))
+  {
+    Period = 0xFFFFFFFF;
+  }
+  SimPeriod = Period;
+  if (!SimFlag)
+  {
+    MatchPeriod = Period;
+  }
+}
+
+static void HW_MaskInt(void)
+{
+  SimIntEnabled = false;
+}
+
+static void HW_UnmaskInt(void)
+{
+  SimIntEnabled = true;
+}
+
+/****************************************************************************
+ Function
+     ES_ShortTimer_SimAdvance
+ Description
+     Host builds only: runs the simulated Timer4/5 for the requested time,
+     taking the 'interrupt' whenever a period match occurs
+****************************************************************************/
+void ES_ShortTimer_SimAdvance(uint32_t Microseconds)
+{
+  uint32_t Ticks = Microseconds * TICKS_PER_US;
+
+  while (Ticks-- > 0)
+  {
+    SimNow++;
+    if (SimCount == SimPeriod)
+    {
+      SimCount  = 0;
+      SimFlag   = true;
+    }
+    else
+    {
+      SimCount++;
+    }
+    if (SimFlag && SimIntEnabled)
+    {
+      ServiceShortTimers();
+    }
+  }
+}
+#endif // HOST_TEST
+
+/***************************************************************************
+ module test harness
+ gcc -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     FrameworkSource/ES_ShortTimer.c -o shorttimer_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
 
-// post the timeout for this timer
-  ThisEvent.EventType   = ES_SHORT_TIMEOUT;
-  ThisEvent.EventParam  = TIMER_B;
-// protect against timer that was not correctly initialized
-  if (Timer_B_Priority != SHORT_TIMER_UNUSED)
+static uint8_t  PostedChannel[16];
+static uint32_t PostedAt[16];
+static uint8_t  NumPosted;
+
+// runs the simulation a microsecond at a time, calling the event checker
+// after each as the event loop would
+static void RunFor(uint32_t Microseconds)
+{
+  while (Microseconds-- > 0)
   {
-    ES_PostToService(Timer_B_Priority, ThisEvent);
+    ES_ShortTimer_SimAdvance(1);
+    ES_ShortTimer_CheckExpired();
   }
 }
 
+static bool RecordPost(ES_Event_t ThisEvent)
+{
+  if ((ThisEvent.EventType == ES_SHORT_TIMEOUT) && (NumPosted < 16))
+  {
+    PostedChannel[NumPosted]  = ThisEvent.EventParam;
+    PostedAt[NumPosted]       = SimNow / TICKS_PER_US;
+    NumPosted++;
+  }
+  return true;
+}
+
+// stand-ins for the post functions of the two channels
+bool PostModeServiceFSM(ES_Event_t ThisEvent)
+{
+  return RecordPost(ThisEvent);
+}
+
+bool PostTestChannel(ES_Event_t ThisEvent)
+{
+  return RecordPost(ThisEvent);
+}
+
+int main(void)
+{
+  uint32_t RestartFrom;
+  uint32_t RollFrom;
+  uint16_t i;
+  bool Passed = true;
+
+  ES_ShortTimer_Init();
+
+  // two channels, the later start expiring first
+  ES_ShortTimer_Start(AudioPulseTimer, 500);
+  ES_ShortTimer_Start(TestPulseTimer, 120);
+  RunFor(100);
+  // restart the audio channel so that it is now due at 100 + 50us
+  ES_ShortTimer_Start(AudioPulseTimer, 50);
+  RunFor(1000);
+  // a stopped channel must not post
+  ES_ShortTimer_Start(TestPulseTimer, 200);
+  RunFor(100);
+  ES_ShortTimer_Stop(TestPulseTimer);
+  RunFor(1000);
+  // a timeout latched by the ISR but not yet posted is dropped by a stop
+  ES_ShortTimer_Start(TestPulseTimer, 10);
+  ES_ShortTimer_SimAdvance(20);
+  ES_ShortTimer_Stop(TestPulseTimer);
+  RunFor(10);
+  // restarting one channel every microsecond must not move the deadline of
+  // the other, the counter is never stopped to re-arm
+  RestartFrom = SimNow / TICKS_PER_US;
+  ES_ShortTimer_Start(AudioPulseTimer, 300);
+  for (i = 0; i < 250; i++)
+  {
+    ES_ShortTimer_Start(TestPulseTimer, 1000);
+    RunFor(1);
+  }
+  ES_ShortTimer_Stop(TestPulseTimer);
+  RunFor(100);
+  // across the roll over at the end of the count, as after 214s of running
+  SimCount = LastCount = 0xFFFFFFFF - 50 * TICKS_PER_US;
+  RollFrom = SimNow / TICKS_PER_US;
+  ES_ShortTimer_Start(AudioPulseTimer, 150);
+  RunFor(200);
+  // an out of range time or an unused channel is rejected
+  if ((ES_ShortTimer_Start(AudioPulseTimer, 0) != ES_Timer_ERR) ||
+      (ES_ShortTimer_Start(NUM_SHORT_TIMERS, 10) != ES_Timer_ERR) ||
+      (ES_ShortTimer_Start(2, 10) != ES_Timer_ERR))
+  {
+    Passed = false;
+  }
+
+  for (i = 0; i < NumPosted; i++)
+  {
+    printf("channel %u expired at %lu us\n", PostedChannel[i],
+        (unsigned long)PostedAt[i]);
+  }
+  if ((NumPosted != 4) ||
+      (PostedChannel[0] != TestPulseTimer) || (PostedAt[0] != 120) ||
+      (PostedChannel[1] != AudioPulseTimer) || (PostedAt[1] != 150) ||
+      (PostedChannel[2] != AudioPulseTimer) ||
+      (PostedAt[2] != RestartFrom + 300) ||
+      (PostedChannel[3] != AudioPulseTimer) || (PostedAt[3] != RollFrom + 150))
+  {
+    Passed = false;
+  }
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -13,6 +13,14 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 00:20 mp      a group must post to the OwnerService that is given
+ 10/18/26 21:00 mp      added ES_Timer_GetActive and ES_Timer_GetRemaining
+ 10/18/26 14:20 mp      added timer groups, stopped or restarted with one
+                        write to TMR_ActiveFlags
+ 10/18/26 13:10 mp      timers in TIMER_COALESCE_MASK that expire together are
+                        posted as one ES_TIMEOUT_SET per response function
+ 10/18/26 09:15 mp      ES_Timer_Tick_Resp takes an elapsed tick count so that
+                        missed ticks are caught up in a single pass
  10/27/14 14:02 jec      moved ticking of 'time' to ES_Port to allow it to tick
                          even while blocking. required change to ES_GetTime too
  10/20/13 10:48 jec      moved definition of BITS_PER_BYTE to ES_General.h
@@ -53,6 +61,13 @@
 /*--------------------------- External Variables --------------------------*/
 
 /*----------------------------- Module Defines ----------------------------*/
+#ifndef TIMER_COALESCE_MASK
+#define TIMER_COALESCE_MASK 0
+#endif
+
+// marks an entry in the expired list that was folded into an earlier
+// ES_TIMEOUT_SET
+#define FOLDED_TIMER 0xFF
 
 /*------------------------------ Module Types -----------------------------*/
 
@@ -67,6 +82,7 @@ typedef uint16_t Tflag_t;
 typedef uint16_t Timer_t; // sets size of timers to 16 bits
 
 /*---------------------------- Module Functions ---------------------------*/
+static bool IsValidGroup(uint8_t OwnerService, uint16_t Mask);
 
 /*---------------------------- Module Variables ---------------------------*/
 static Timer_t TMR_TimerArray[sizeof(Tflag_t) * BITS_PER_BYTE] =
@@ -91,6 +107,9 @@ static Timer_t TMR_TimerArray[sizeof(Tflag_t) * BITS_PER_BYTE] =
 
 static Tflag_t TMR_ActiveFlags;
 
+// the last time set on each timer, used by ES_Timer_RestartGroup
+static Timer_t TMR_ReloadArray[sizeof(Tflag_t) * BITS_PER_BYTE];
+
 static pPostFunc const Timer2PostFunc[sizeof(Tflag_t) * BITS_PER_BYTE] =
 {
   TIMER0_RESP_FUNC,
@@ -111,6 +130,57 @@ static pPostFunc const Timer2PostFunc[sizeof(Tflag_t) * BITS_PER_BYTE] =
   TIMER15_RESP_FUNC
 };
 
+// the post function of each service, to check the owner of a timer group
+static pPostFunc const Service2PostFunc[NUM_SERVICES] =
+{
+  SERV_0_POST
+#if NUM_SERVICES > 1
+  , SERV_1_POST
+#endif
+#if NUM_SERVICES > 2
+  , SERV_2_POST
+#endif
+#if NUM_SERVICES > 3
+  , SERV_3_POST
+#endif
+#if NUM_SERVICES > 4
+  , SERV_4_POST
+#endif
+#if NUM_SERVICES > 5
+  , SERV_5_POST
+#endif
+#if NUM_SERVICES > 6
+  , SERV_6_POST
+#endif
+#if NUM_SERVICES > 7
+  , SERV_7_POST
+#endif
+#if NUM_SERVICES > 8
+  , SERV_8_POST
+#endif
+#if NUM_SERVICES > 9
+  , SERV_9_POST
+#endif
+#if NUM_SERVICES > 10
+  , SERV_10_POST
+#endif
+#if NUM_SERVICES > 11
+  , SERV_11_POST
+#endif
+#if NUM_SERVICES > 12
+  , SERV_12_POST
+#endif
+#if NUM_SERVICES > 13
+  , SERV_13_POST
+#endif
+#if NUM_SERVICES > 14
+  , SERV_14_POST
+#endif
+#if NUM_SERVICES > 15
+  , SERV_15_POST
+#endif
+};
+
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
  Function
@@ -160,7 +230,8 @@ ES_TimerReturn_t ES_Timer_SetTimer(uint8_t Num, uint16_t NewTime)
   {
     return ES_Timer_ERR;
   }
-  TMR_TimerArray[Num] = NewTime;
+  TMR_TimerArray[Num]   = NewTime;
+  TMR_ReloadArray[Num]  = NewTime;
   return ES_Timer_OK;
 }
 
@@ -244,11 +315,143 @@ ES_TimerReturn_t ES_Timer_InitTimer(uint8_t Num, uint16_t NewTime)
   {
     return ES_Timer_ERR;
   }
-  TMR_TimerArray[Num] = NewTime;
-  TMR_ActiveFlags     |= BitNum2SetMask[Num]; /* set timer as active */
+  TMR_TimerArray[Num]   = NewTime;
+  TMR_ReloadArray[Num]  = NewTime;
+  TMR_ActiveFlags       |= BitNum2SetMask[Num]; /* set timer as active */
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_StopGroup
+ Parameters
+     uint8_t OwnerService, the service that the group's timers post to
+     uint16_t Mask, the group of timers, one bit per timer number
+ Returns
+     ES_Timer_ERR if the timers in the group do not all post to
+     OwnerService, ES_Timer_OK otherwise.
+ Description
+     stops every timer in the group with a single write to TMR_ActiveFlags,
+     then removes any timeouts from the group that are still waiting in the
+     owner's queue, so that nothing from the group arrives after this call.
+ Notes
+     OwnerService is the priority (queue index) of the owning service. It
+     is checked against the group's post function through SERV_n_POST, so
+     that the purge can not hit another service's queue.
+ Author
+     M. Peraza, 10/18/26 14:20
+****************************************************************************/
+ES_TimerReturn_t ES_Timer_StopGroup(uint8_t OwnerService, uint16_t Mask)
+{
+  if (IsValidGroup(OwnerService, Mask) != true)
+  {
+    return ES_Timer_ERR;
+  }
+  TMR_ActiveFlags &= ~Mask;   /* set the whole group inactive */
+  if (ES_PurgeTimeoutEvents(OwnerService, Mask) != true)
+  {
+    return ES_Timer_ERR;
+  }
   return ES_Timer_OK;
 }
 
+/****************************************************************************
+ Function
+     ES_Timer_RestartGroup
+ Parameters
+     uint8_t OwnerService, the service that the group's timers post to
+     uint16_t Mask, the group of timers, one bit per timer number
+ Returns
+     ES_Timer_ERR if the timers in the group do not all post to
+     OwnerService or one of them has never had a time set, ES_Timer_OK
+     otherwise.
+ Description
+     reloads every timer in the group with the last time that was set on it,
+     removes any pending timeouts from the group from the owner's queue and
+     then starts the whole group with a single write to TMR_ActiveFlags.
+ Notes
+     OwnerService is the priority (queue index) of the owning service. It
+     is checked against the group's post function through SERV_n_POST, so
+     that the purge can not hit another service's queue.
+ Author
+     M. Peraza, 10/18/26 14:20
+****************************************************************************/
+ES_TimerReturn_t ES_Timer_RestartGroup(uint8_t OwnerService, uint16_t Mask)
+{
+  uint16_t  Remaining;
+  uint8_t   Num;
+
+  if (IsValidGroup(OwnerService, Mask) != true)
+  {
+    return ES_Timer_ERR;
+  }
+  // check that they all have a time before touching any of them
+  for (Remaining = Mask; Remaining != 0; Remaining &= BitNum2ClrMask[Num])
+  {
+    Num = ES_GetMSBitSet(Remaining);
+    if (TMR_ReloadArray[Num] == 0)
+    {
+      return ES_Timer_ERR;
+    }
+  }
+  for (Remaining = Mask; Remaining != 0; Remaining &= BitNum2ClrMask[Num])
+  {
+    Num = ES_GetMSBitSet(Remaining);
+    TMR_TimerArray[Num] = TMR_ReloadArray[Num];
+  }
+  if (ES_PurgeTimeoutEvents(OwnerService, Mask) != true)
+  {
+    return ES_Timer_ERR;
+  }
+  TMR_ActiveFlags |= Mask;    /* set the whole group active */
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_GetActive
+ Parameters
+     None
+ Returns
+     uint16_t, one bit set for each timer that is running
+ Description
+     lets the shell list the running timers
+ Author
+     M. Peraza, 10/18/26 21:00
+****************************************************************************/
+uint16_t ES_Timer_GetActive(void)
+{
+  return TMR_ActiveFlags;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_GetRemaining
+ Parameters
+     uint8_t Num, the number of the timer to look at
+ Returns
+     uint16_t, the ticks left before the timer expires, 0 if it is not
+     running or there is no such timer
+ Description
+     lets the shell show how long each running timer has to go
+ Notes
+     the count is as of the last tick that was processed, so it can be high
+     by the ticks that are waiting in ES_Port
+ Author
+     M. Peraza, 10/18/26 21:00
+****************************************************************************/
+uint16_t ES_Timer_GetRemaining(uint8_t Num)
+{
+  uint16_t Remaining = 0;
+
+  if ((Num < ARRAY_SIZE(TMR_TimerArray)) &&
+      ((TMR_ActiveFlags & BitNum2SetMask[Num]) != 0))
+  {
+    Remaining = TMR_TimerArray[Num];
+  }
+  return Remaining;
+}
+
 /****************************************************************************
  Function
      ES_Timer_GetTime
@@ -274,28 +477,41 @@ uint16_t ES_Timer_GetTime(void)
  Function
      ES_Timer_Tick_Resp
  Parameters
-     None.
+     uint16_t ElapsedTicks, the number of ticks that have passed since the
+     last call (normally 1, more if the tick processing was delayed)
  Returns
      None.
  Description
      This is the new Tick response routine to support the timer module.
-     It will increment time, to maintain the functionality of the
-     GetTime() timer and it will check through the active timers,
-     decrementing each active timers count, if the count goes to 0, it
-     will post an event to the corresponding SM and clear the active flag to
-     prevent further counting.
+     It walks the active timers once, advancing each active timer's count by
+     ElapsedTicks. Any timer whose count would reach 0 within that window is
+     stopped and its timeout event is posted to the corresponding SM. Timers
+     that expired in the same window are posted in the order in which they
+     expired (earliest first); timers that expired on the same tick are
+     posted highest timer number first, as before.
+     Timers in TIMER_COALESCE_MASK that expired on the same tick and post to
+     the same function are reported together with one ES_TIMEOUT_SET whose
+     parameter is the mask of those timers.
  Notes
-     Called from _Timer_Int_Resp in ES_Port.c.
+     Called from _HW_Process_Pending_Ints in ES_Port.c.
  Author
      J. Edward Carryer, 02/24/97 15:06
 ****************************************************************************/
-void ES_Timer_Tick_Resp(void)
+void ES_Timer_Tick_Resp(uint16_t ElapsedTicks)
 {
   static Tflag_t  NeedsProcessing;
   static uint8_t  NextTimer2Process;
   static ES_Event_t NewEvent;
+  // timers that expired during this window, sorted by the tick on which
+  // they expired
+  static uint8_t  ExpiredTimers[sizeof(Tflag_t) * BITS_PER_BYTE];
+  static Timer_t  ExpiredAt[sizeof(Tflag_t) * BITS_PER_BYTE];
+  uint8_t         NumExpired = 0;
+  uint8_t         i;
+  uint8_t         j;
+  uint16_t        ExpiredSet;
 
-  if (TMR_ActiveFlags != 0) /* if !=0 , then at least 1 timer is active */
+  if ((TMR_ActiveFlags != 0) && (ElapsedTicks != 0)) /* at least 1 active */
   {
     // start by getting a list of all the active timers
     NeedsProcessing = TMR_ActiveFlags;
@@ -303,20 +519,94 @@ void ES_Timer_Tick_Resp(void)
     {
       // find the MSB that is set
       NextTimer2Process = ES_GetMSBitSet(NeedsProcessing);
-      /* decrement that timer, check if timed out */
-      if (--TMR_TimerArray[NextTimer2Process] == 0)
+      /* advance that timer, check if it timed out during this window */
+      if (TMR_TimerArray[NextTimer2Process] <= ElapsedTicks)
       {
-        NewEvent.EventType  = ES_TIMEOUT;
-        NewEvent.EventParam = NextTimer2Process;
-        /* post the timeout event to the right Service */
-        Timer2PostFunc[NextTimer2Process](NewEvent);
+        // insert into the expired list, keeping it sorted by expiry tick.
+        // Using '>' keeps timers that expired on the same tick in MSB order
+        for (i = NumExpired;
+            (i > 0) && (ExpiredAt[i - 1] > TMR_TimerArray[NextTimer2Process]);
+            i--)
+        {
+          ExpiredTimers[i]  = ExpiredTimers[i - 1];
+          ExpiredAt[i]      = ExpiredAt[i - 1];
+        }
+        ExpiredTimers[i]  = NextTimer2Process;
+        ExpiredAt[i]      = TMR_TimerArray[NextTimer2Process];
+        NumExpired++;
+        TMR_TimerArray[NextTimer2Process] = 0;
         /* and stop counting */
         TMR_ActiveFlags &= BitNum2ClrMask[NextTimer2Process];
       }
+      else
+      {
+        TMR_TimerArray[NextTimer2Process] -= ElapsedTicks;
+      }
       // mark off the active timer that we just processed
       NeedsProcessing &= BitNum2ClrMask[NextTimer2Process];
     } while (NeedsProcessing != 0);
+
+    // now post the timeout events in the order that the timers expired
+    for (i = 0; i < NumExpired; i++)
+    {
+      NextTimer2Process = ExpiredTimers[i];
+      if (NextTimer2Process == FOLDED_TIMER)
+      {
+        continue; // already reported as part of an earlier set
+      }
+      NewEvent.EventType  = ES_TIMEOUT;
+      NewEvent.EventParam = NextTimer2Process;
+      if ((BitNum2SetMask[NextTimer2Process] & TIMER_COALESCE_MASK) != 0)
+      {
+        // timers that expired on the same tick follow this one in the list,
+        // fold the ones with the same destination into a single set
+        ExpiredSet = BitNum2SetMask[NextTimer2Process];
+        for (j = i + 1; (j < NumExpired) && (ExpiredAt[j] == ExpiredAt[i]); j++)
+        {
+          if ((ExpiredTimers[j] != FOLDED_TIMER) &&
+              ((BitNum2SetMask[ExpiredTimers[j]] & TIMER_COALESCE_MASK) != 0) &&
+              (Timer2PostFunc[ExpiredTimers[j]] ==
+              Timer2PostFunc[NextTimer2Process]))
+          {
+            ExpiredSet |= BitNum2SetMask[ExpiredTimers[j]];
+            ExpiredTimers[j] = FOLDED_TIMER;
+          }
+        }
+        if (ExpiredSet != BitNum2SetMask[NextTimer2Process])
+        {
+          NewEvent.EventType  = ES_TIMEOUT_SET;
+          NewEvent.EventParam = ExpiredSet;
+        }
+      }
+      /* post the timeout event to the right Service */
+      Timer2PostFunc[NextTimer2Process](NewEvent);
+    }
+  }
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+// a group is valid when all of its timers post to the post function of
+// OwnerService, which means that they belong to that service
+static bool IsValidGroup(uint8_t OwnerService, uint16_t Mask)
+{
+  uint8_t Num;
+
+  if (OwnerService >= NUM_SERVICES)
+  {
+    return false;
+  }
+  while (Mask != 0)
+  {
+    Num = ES_GetMSBitSet(Mask);
+    if (Timer2PostFunc[Num] != Service2PostFunc[OwnerService])
+    {
+      return false;
+    }
+    Mask &= BitNum2ClrMask[Num];
   }
+  return true;
 }
 
 /*------------------------------- Footnotes -------------------------------*/
@@ -0,0 +1,194 @@
+//#define TEST
+/****************************************************************************
+  Module
+    dblog.c
+
+  Description
+    Deferred formatting log for the hot paths. Where DB_printf formats the
+    whole line on the PIC32, DB_LOG only writes a short binary record: the
+    address of the format string and the raw argument words. The host turns
+    the records back into text with Tools/dblog_decode.py, which reads the
+    format strings out of the .dblog_fmt section of the ELF file.
+
+  Notes
+    A record is laid out as
+      DB_LOG_SYNC, argument count, format address (4 bytes, LS byte first),
+      then each argument (4 bytes, LS byte first)
+    and is written to the terminal transmit buffer in one piece with
+    Terminal_WriteRecord, so it shares the UART with DB_printf output. A
+    record that does not fit is dropped whole and shows up in
+    Terminal_GetTxOverruns.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 18:30 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "terminal.h"
+#include "dblog.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DB_LOG_MAX_RECORD (DB_LOG_HEADER_LEN + 4 * DB_LOG_MAX_ARGS)
+
+/*---------------------------- Module Functions ---------------------------*/
+static uint8_t *PutWord(uint8_t *pBuffer, uint32_t Word);
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    DB_LogWrite
+
+ Parameters
+    the format string, a pointer to the argument words, number of arguments
+
+ Returns
+    None.
+
+ Description
+    builds a log record and queues it for the UART. Normally called through
+    the DB_LOG macro rather than directly, so that the format string ends up
+    in the .dblog_fmt section where the decoder can find it.
+ Notes
+    Arguments past DB_LOG_MAX_ARGS are ignored.
+ Author
+    M. Peraza, 10/18/26 18:30
+****************************************************************************/
+void DB_LogWrite(const char *pFormat, const uint32_t *pArgs, uint8_t NumArgs)
+{
+  uint8_t Record[DB_LOG_MAX_RECORD];
+  uint8_t *pRecord;
+  uint8_t i;
+
+  if (NumArgs > DB_LOG_MAX_ARGS)
+  {
+    NumArgs = DB_LOG_MAX_ARGS;
+  }
+  Record[0] = DB_LOG_SYNC;
+  Record[1] = NumArgs;
+  pRecord = PutWord(&Record[2], (uint32_t)(uintptr_t)pFormat);
+  for (i = 0; i < NumArgs; i++)
+  {
+    pRecord = PutWord(pRecord, pArgs[i]);
+  }
+  Terminal_WriteRecord(Record, pRecord - Record);
+}
+
+/*************************************************************************
+ private functions
+ *************************************************************************/
+static uint8_t *PutWord(uint8_t *pBuffer, uint32_t Word)
+{
+  pBuffer[0] = (uint8_t)Word;
+  pBuffer[1] = (uint8_t)(Word >> 8);
+  pBuffer[2] = (uint8_t)(Word >> 16);
+  pBuffer[3] = (uint8_t)(Word >> 24);
+  return pBuffer + 4;
+}
+
+/*************************************************************************
+ host test harness, checks the record layout and then measures the cost of
+ a DB_printf and of a DB_LOG call with the same format and arguments. The
+ buffer is emptied between batches, outside of the timed part.
+ gcc -c -IFrameworkHeaders FrameworkSource/spsc_ring.c
+ gcc -O2 -DHOST_TEST -c -IFrameworkHeaders -IProjectHeaders \
+     FrameworkSource/terminal.c FrameworkSource/dbprintf.c
+ gcc -O2 -DTEST -DHOST_TEST -pthread -IFrameworkHeaders -IProjectHeaders \
+     FrameworkSource/dblog.c terminal.o dbprintf.o spsc_ring.o -o dblog_test
+ *************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include <string.h>
+#include "dbprintf.h"
+
+#define CALLS_PER_BATCH 16
+#define NUM_BATCHES     20000
+
+static void Drain(void)
+{
+  uint8_t Discard[64];
+  while (Terminal_SimDrain(Discard, sizeof(Discard)) != 0)
+  {}
+}
+
+static bool CheckRecord(void)
+{
+  uint8_t Bytes[DB_LOG_MAX_RECORD];
+  static const char Format[] = "state %d event %d param %x\n";
+  const uint32_t Args[] = { 3, (uint32_t)-2, 0x1234 };
+  uint8_t Expected[DB_LOG_HEADER_LEN + sizeof(Args)];
+  size_t NumBytes;
+
+  Drain();
+  Expected[0] = DB_LOG_SYNC;
+  Expected[1] = 3;
+  PutWord(PutWord(PutWord(PutWord(&Expected[2],
+      (uint32_t)(uintptr_t)Format), Args[0]), Args[1]), Args[2]);
+  DB_LogWrite(Format, Args, 3);
+  NumBytes = Terminal_SimDrain(Bytes, sizeof(Bytes));
+  return (NumBytes == sizeof(Expected)) &&
+         (memcmp(Bytes, Expected, sizeof(Expected)) == 0);
+}
+
+static bool CheckAllOrNothing(void)
+{
+  static uint8_t Bytes[XMIT_BUFFER_SIZE];
+  uint32_t Dropped;
+  uint16_t i;
+
+  // fill the buffer up with records, the last one that does not fit must
+  // be dropped whole
+  Drain();
+  Dropped = Terminal_GetTxOverruns();
+  for (i = 0; i < XMIT_BUFFER_SIZE / 18 + 1; i++)
+  {
+    DB_LOG("fill %d %d %d\n", i, i, i);
+  }
+  // 1024 bytes hold 56 records of 18 bytes, the rest are dropped
+  return (Terminal_GetTxOverruns() - Dropped == 18) &&
+         (Terminal_SimDrain(Bytes, sizeof(Bytes)) == 56 * 18) &&
+         (Bytes[55 * 18] == DB_LOG_SYNC);
+}
+
+int main(void)
+{
+  uint32_t PrintfTicks = 0;
+  uint32_t LogTicks = 0;
+  uint32_t Start;
+  uint32_t Batch;
+  uint32_t i;
+
+  Terminal_HWInit();
+  if (!CheckRecord() || !CheckAllOrNothing())
+  {
+    puts("FAIL");
+    return 1;
+  }
+
+  for (Batch = 0; Batch < NUM_BATCHES; Batch++)
+  {
+    Drain();
+    Start = _HW_GetTimeStamp();
+    for (i = 0; i < CALLS_PER_BATCH; i++)
+    {
+      DB_printf("state %d event %d param %x\n", (int)i, (int)Batch, 0xbeef);
+    }
+    PrintfTicks += _HW_GetTimeStamp() - Start;
+
+    Drain();
+    Start = _HW_GetTimeStamp();
+    for (i = 0; i < CALLS_PER_BATCH; i++)
+    {
+      DB_LOG("state %d event %d param %x\n", i, Batch, 0xbeef);
+    }
+    LogTicks += _HW_GetTimeStamp() - Start;
+  }
+  fprintf(stdout, "DB_printf %lu ns/call, DB_LOG %lu ns/call\n",
+      (unsigned long)(PrintfTicks * (1000ULL / ES_TIMESTAMP_TICKS_PER_US) /
+                      (NUM_BATCHES * CALLS_PER_BATCH)),
+      (unsigned long)(LogTicks * (1000ULL / ES_TIMESTAMP_TICKS_PER_US) /
+                      (NUM_BATCHES * CALLS_PER_BATCH)));
+  puts("PASS");
+  return 0;
+}
+#endif // TEST && HOST_TEST
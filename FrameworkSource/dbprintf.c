@@ -20,6 +20,8 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 15:00 mp      write the finished line with Terminal_Write, one call
+                        per line, instead of one putchar per character
  10/06/20 22:53 ram     updated to use the terminal module. Updated variable 
                         names to make MPLAB happy during parsing
  05/15/02 21:40 jec      converted to use SC1 for use in me218c project master
@@ -46,6 +48,7 @@
 static void uitoa(char **buf, unsigned int i, unsigned int baseNum);
 
 /*---------------------------- Module Variables ---------------------------*/
+static const uint8_t CRLF[] = { CR, LF };
 
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
@@ -134,18 +137,18 @@ void DB_printf(const char *Format, ...)
   }
   *pBuffer = 0;                     /* null terminate the output string */
 
-/* now, spit the built up line out 1 character at a time */
+/* now, spit the built up line out, a line at a time, expanding \n to CR LF */
+   pString = LineBuffer;
    for (pBuffer = LineBuffer; *pBuffer != 0; pBuffer++)
    {
-      if (*pBuffer != '\n')
-      {   
-        putchar(*pBuffer);
-      }else
+      if (*pBuffer == '\n')
       {
-         putchar(CR);
-         putchar(LF);
+         Terminal_Write((uint8_t *)pString, pBuffer - pString);
+         Terminal_Write(CRLF, sizeof(CRLF));
+         pString = pBuffer + 1;
       }
    }
+   Terminal_Write((uint8_t *)pString, pBuffer - pString);
    return;
 }
 /* integer to ascii conversion for unsigned numbers  */
@@ -0,0 +1,541 @@
+/****************************************************************************
+ Module
+   spsc_ring.c
+
+ Revision
+   1.0.0
+
+ Description
+   Lock free single producer, single consumer byte ring, for passing bytes
+   between an ISR and the main loop on the PIC32, or between two threads in
+   a host build.
+
+ Notes
+   The producer fills a slot and then publishes it with a release store to
+   Head. The consumer reads Head with an acquire load before it reads the
+   slot, so it always sees the data. It does the same in the other
+   direction with Tail, so a slot is not refilled until the consumer is done
+   with it. A side only writes its own index, so neither side ever needs to
+   turn interrupts off or take a lock.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      the harness uses Seconds from host_test.h
+ 10/19/26 00:10 mp      the harness times single bytes against ranges
+ 10/18/26 20:00 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <assert.h>
+#include <string.h>
+#include "spsc_ring.h"
+
+/*---------------------------- Module Functions ---------------------------*/
+static void CopyIn(SPSCRing_t *pRing, uint32_t Index, const uint8_t *pBytes,
+                   size_t Count);
+static void CopyOut(const SPSCRing_t *pRing, uint32_t Index, uint8_t *pBytes,
+                    size_t Count);
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   SPSCRing_Init
+
+ Parameters
+   SPSCRing_t *pRing : the ring to set up
+   uint8_t *pStorage : space for the bytes
+   uint32_t Size : size of pStorage, a power of two
+
+ Returns
+   nothing
+
+ Description
+   Sets the ring up empty. Must be done before either side uses it.
+ Author
+   M. Peraza, 10/18/26 20:00
+****************************************************************************/
+void SPSCRing_Init(SPSCRing_t *pRing, uint8_t *pStorage, uint32_t Size)
+{
+  assert(pRing && pStorage);
+  assert((Size != 0) && ((Size & (Size - 1)) == 0));
+
+  pRing->pStorage = pStorage;
+  pRing->Mask = Size - 1;
+  pRing->Head = 0;
+  pRing->CachedTail = 0;
+  pRing->Tail = 0;
+  pRing->CachedHead = 0;
+}
+
+/****************************************************************************
+ Function
+   SPSCRing_Free
+
+ Parameters
+   SPSCRing_t *pRing : the ring
+
+ Returns
+   size_t : number of bytes that the producer can put right now
+
+ Description
+   Producer side only. The consumer may make more room at any time, but
+   never less, so a put of up to this many bytes will not fail.
+ Author
+   M. Peraza, 10/18/26 20:00
+****************************************************************************/
+size_t SPSCRing_Free(SPSCRing_t *pRing)
+{
+  uint32_t Head = __atomic_load_n(&pRing->Head, __ATOMIC_RELAXED);
+
+  pRing->CachedTail = __atomic_load_n(&pRing->Tail, __ATOMIC_ACQUIRE);
+  return pRing->Mask + 1 - (Head - pRing->CachedTail);
+}
+
+/****************************************************************************
+ Function
+   SPSCRing_Put
+
+ Parameters
+   SPSCRing_t *pRing : the ring
+   uint8_t Byte : the byte to add
+
+ Returns
+   bool : true if the byte was added, false if the ring was full
+
+ Description
+   Producer side only.
+ Author
+   M. Peraza, 10/18/26 20:00
+****************************************************************************/
+bool SPSCRing_Put(SPSCRing_t *pRing, uint8_t Byte)
+{
+  uint32_t Head = __atomic_load_n(&pRing->Head, __ATOMIC_RELAXED);
+
+  if (Head - pRing->CachedTail > pRing->Mask)
+  {
+    // full as far as we knew, see if the consumer has moved on
+    pRing->CachedTail = __atomic_load_n(&pRing->Tail, __ATOMIC_ACQUIRE);
+    if (Head - pRing->CachedTail > pRing->Mask)
+    {
+      return false;
+    }
+  }
+  pRing->pStorage[Head & pRing->Mask] = Byte;
+  __atomic_store_n(&pRing->Head, Head + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+/****************************************************************************
+ Function
+   SPSCRing_PutRange
+
+ Parameters
+   SPSCRing_t *pRing : the ring
+   const uint8_t *pBytes : the bytes to add
+   size_t Count : how many
+
+ Returns
+   size_t : how many were added, fewer than Count if the ring filled up
+
+ Description
+   Producer side only. Copies in at most two pieces and publishes them all
+   at once.
+ Author
+   M. Peraza, 10/18/26 20:00
+****************************************************************************/
+size_t SPSCRing_PutRange(SPSCRing_t *pRing, const uint8_t *pBytes,
+                         size_t Count)
+{
+  uint32_t Head = __atomic_load_n(&pRing->Head, __ATOMIC_RELAXED);
+  size_t Room = pRing->Mask + 1 - (Head - pRing->CachedTail);
+
+  if (Room < Count)
+  {
+    Room = SPSCRing_Free(pRing);
+    if (Room < Count)
+    {
+      Count = Room;
+    }
+  }
+  if (Count != 0)
+  {
+    CopyIn(pRing, Head, pBytes, Count);
+    __atomic_store_n(&pRing->Head, Head + (uint32_t)Count, __ATOMIC_RELEASE);
+  }
+  return Count;
+}
+
+/****************************************************************************
+ Function
+   SPSCRing_Get
+
+ Parameters
+   SPSCRing_t *pRing : the ring
+   uint8_t *pByte : where to put the byte
+
+ Returns
+   bool : true if there was a byte, false if the ring was empty
+
+ Description
+   Consumer side only.
+ Author
+   M. Peraza, 10/18/26 20:00
+****************************************************************************/
+bool SPSCRing_Get(SPSCRing_t *pRing, uint8_t *pByte)
+{
+  uint32_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_RELAXED);
+
+  if (Tail == pRing->CachedHead)
+  {
+    // empty as far as we knew, see if the producer has added anything
+    pRing->CachedHead = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);
+    if (Tail == pRing->CachedHead)
+    {
+      return false;
+    }
+  }
+  *pByte = pRing->pStorage[Tail & pRing->Mask];
+  __atomic_store_n(&pRing->Tail, Tail + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+/****************************************************************************
+ Function
+   SPSCRing_GetRange
+
+ Parameters
+   SPSCRing_t *pRing : the ring
+   uint8_t *pBytes : where to put the bytes
+   size_t MaxCount : the most to take
+
+ Returns
+   size_t : how many were taken
+
+ Description
+   Consumer side only. Copies out in at most two pieces and frees them all
+   at once.
+ Author
+   M. Peraza, 10/18/26 20:00
+****************************************************************************/
+size_t SPSCRing_GetRange(SPSCRing_t *pRing, uint8_t *pBytes, size_t MaxCount)
+{
+  uint32_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_RELAXED);
+  size_t Available = pRing->CachedHead - Tail;
+
+  if (Available < MaxCount)
+  {
+    pRing->CachedHead = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);
+    Available = pRing->CachedHead - Tail;
+    if (Available < MaxCount)
+    {
+      MaxCount = Available;
+    }
+  }
+  if (MaxCount != 0)
+  {
+    CopyOut(pRing, Tail, pBytes, MaxCount);
+    __atomic_store_n(&pRing->Tail, Tail + (uint32_t)MaxCount, __ATOMIC_RELEASE);
+  }
+  return MaxCount;
+}
+
+/****************************************************************************
+ Function
+   SPSCRing_IsEmpty
+
+ Parameters
+   SPSCRing_t *pRing : the ring
+
+ Returns
+   bool : true if there is nothing to get
+
+ Description
+   Consumer side only.
+ Author
+   M. Peraza, 10/18/26 20:00
+****************************************************************************/
+bool SPSCRing_IsEmpty(SPSCRing_t *pRing)
+{
+  uint32_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_RELAXED);
+
+  if (Tail != pRing->CachedHead)
+  {
+    return false;
+  }
+  pRing->CachedHead = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);
+  return Tail == pRing->CachedHead;
+}
+
+/****************************************************************************
+ Function
+   SPSCRing_Count
+
+ Parameters
+   const SPSCRing_t *pRing : the ring
+
+ Returns
+   size_t : number of bytes in the ring
+
+ Description
+   May be called from either side, or from neither, but the other side can
+   change the count straight away.
+ Author
+   M. Peraza, 10/18/26 20:00
+****************************************************************************/
+size_t SPSCRing_Count(const SPSCRing_t *pRing)
+{
+  uint32_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_ACQUIRE);
+  uint32_t Head = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);
+
+  // Tail first, so that Head can only be newer and the count never negative
+  return Head - Tail;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+static void CopyIn(SPSCRing_t *pRing, uint32_t Index, const uint8_t *pBytes,
+                   size_t Count)
+{
+  uint32_t Start = Index & pRing->Mask;
+  size_t First = pRing->Mask + 1 - Start;
+
+  if (First > Count)
+  {
+    First = Count;
+  }
+  memcpy(&pRing->pStorage[Start], pBytes, First);
+  memcpy(pRing->pStorage, pBytes + First, Count - First);
+}
+
+static void CopyOut(const SPSCRing_t *pRing, uint32_t Index, uint8_t *pBytes,
+                    size_t Count)
+{
+  uint32_t Start = Index & pRing->Mask;
+  size_t First = pRing->Mask + 1 - Start;
+
+  if (First > Count)
+  {
+    First = Count;
+  }
+  memcpy(pBytes, &pRing->pStorage[Start], First);
+  memcpy(pBytes + First, pRing->pStorage, Count - First);
+}
+
+/***************************************************************************
+ host test: times single byte calls against range calls on one thread,
+ then a producer and a consumer thread pass a long pseudo random byte
+ stream through a small ring, each mixing single byte and range calls of
+ random length, and the consumer checks every byte
+ gcc -O2 -DTEST -DHOST_TEST -pthread -IFrameworkHeaders \
+     FrameworkSource/spsc_ring.c -o spsc_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include "host_test.h"
+
+#define STRESS_BYTES (16u * 1024u * 1024u)
+#define MAX_CHUNK    37
+#define BENCH_BYTES  (64u * 1024u * 1024u)
+#define BENCH_LINE   80
+
+static SPSCRing_t Ring;
+static uint8_t Storage[256];
+static uint8_t BenchStorage[1024];
+
+// byte n of the stream, so that a lost or repeated byte is caught even if
+// it happens a multiple of 256 bytes apart
+static uint8_t StreamByte(uint32_t n)
+{
+  return (uint8_t)((n * 2654435761u) >> 24);
+}
+
+// a cheap per thread random number for chunk lengths
+static uint32_t NextRandom(uint32_t *pState)
+{
+  *pState ^= *pState << 13;
+  *pState ^= *pState >> 17;
+  *pState ^= *pState << 5;
+  return *pState;
+}
+
+static void *Producer(void *pArg)
+{
+  uint8_t Chunk[MAX_CHUNK];
+  uint32_t Random = 0x12345678;
+  uint32_t Sent = 0;
+  size_t Length;
+  size_t i;
+
+  (void)pArg;
+  while (Sent < STRESS_BYTES)
+  {
+    Length = NextRandom(&Random) % MAX_CHUNK + 1;
+    if (Length > STRESS_BYTES - Sent)
+    {
+      Length = STRESS_BYTES - Sent;
+    }
+    if (Length == 1)
+    {
+      Length = SPSCRing_Put(&Ring, StreamByte(Sent)) ? 1 : 0;
+    }
+    else
+    {
+      for (i = 0; i < Length; i++)
+      {
+        Chunk[i] = StreamByte(Sent + i);
+      }
+      Length = SPSCRing_PutRange(&Ring, Chunk, Length);
+    }
+    if (Length == 0)
+    {
+      // let the consumer run, the host may have fewer cores than threads
+      sched_yield();
+    }
+    Sent += Length;
+  }
+  return NULL;
+}
+
+static void *Consumer(void *pArg)
+{
+  uint8_t Chunk[MAX_CHUNK];
+  uint32_t Random = 0x87654321;
+  uint32_t Received = 0;
+  size_t Length;
+  size_t i;
+  bool *pPassed = pArg;
+
+  *pPassed = true;
+  while (Received < STRESS_BYTES)
+  {
+    Length = NextRandom(&Random) % MAX_CHUNK + 1;
+    if (Length == 1)
+    {
+      Length = SPSCRing_Get(&Ring, Chunk) ? 1 : 0;
+    }
+    else
+    {
+      Length = SPSCRing_GetRange(&Ring, Chunk, Length);
+    }
+    if (Length == 0)
+    {
+      sched_yield();
+    }
+    for (i = 0; i < Length; i++)
+    {
+      if (Chunk[i] != StreamByte(Received + i))
+      {
+        fprintf(stdout, "wrong byte at %u\n", (unsigned)(Received + i));
+        *pPassed = false;
+        return NULL;
+      }
+    }
+    Received += Length;
+  }
+  return NULL;
+}
+
+// single threaded checks of the edges: a full ring takes no more, and all
+// of the storage can be used
+static bool CheckEdges(void)
+{
+  uint8_t Bytes[sizeof(Storage) + 1];
+  size_t i;
+
+  SPSCRing_Init(&Ring, Storage, sizeof(Storage));
+  for (i = 0; i < sizeof(Bytes); i++)
+  {
+    Bytes[i] = (uint8_t)i;
+  }
+  if ((SPSCRing_PutRange(&Ring, Bytes, 100) != 100) ||
+      (SPSCRing_GetRange(&Ring, Bytes, 60) != 60) ||
+      (SPSCRing_PutRange(&Ring, Bytes, sizeof(Bytes)) != sizeof(Storage) - 40) ||
+      SPSCRing_Put(&Ring, 0) || (SPSCRing_Free(&Ring) != 0) ||
+      (SPSCRing_Count(&Ring) != sizeof(Storage)) ||
+      (SPSCRing_GetRange(&Ring, Bytes, sizeof(Bytes)) != sizeof(Storage)) ||
+      !SPSCRing_IsEmpty(&Ring) || (SPSCRing_Free(&Ring) != sizeof(Storage)))
+  {
+    return false;
+  }
+  return true;
+}
+
+// one thread, a line at a time in and out: a byte at a time with
+// SPSCRing_Put and SPSCRing_Get against SPSCRing_PutRange and GetRange
+static bool Bench(void)
+{
+  uint8_t Line[BENCH_LINE];
+  uint8_t Out[BENCH_LINE];
+  uint32_t Moved;
+  uint32_t Sum = 0;
+  size_t i;
+  double Start;
+
+  SPSCRing_Init(&Ring, BenchStorage, sizeof(BenchStorage));
+  for (i = 0; i < BENCH_LINE; i++)
+  {
+    Line[i] = (uint8_t)i;
+  }
+
+  Start = Seconds();
+  for (Moved = 0; Moved < BENCH_BYTES; Moved += BENCH_LINE)
+  {
+    for (i = 0; i < BENCH_LINE; i++)
+    {
+      SPSCRing_Put(&Ring, Line[i]);
+    }
+    for (i = 0; i < BENCH_LINE; i++)
+    {
+      SPSCRing_Get(&Ring, &Out[i]);
+    }
+    Sum += Out[BENCH_LINE - 1];
+  }
+  fprintf(stdout, "single byte: %6.1f MB/s\n",
+          BENCH_BYTES / (Seconds() - Start) / 1e6);
+
+  Start = Seconds();
+  for (Moved = 0; Moved < BENCH_BYTES; Moved += BENCH_LINE)
+  {
+    SPSCRing_PutRange(&Ring, Line, BENCH_LINE);
+    SPSCRing_GetRange(&Ring, Out, BENCH_LINE);
+    Sum += Out[BENCH_LINE - 1];
+  }
+  fprintf(stdout, "range:       %6.1f MB/s\n",
+          BENCH_BYTES / (Seconds() - Start) / 1e6);
+
+  // every line ends in BENCH_LINE - 1, which also keeps the loops from
+  // being optimized away
+  Moved = (BENCH_BYTES + BENCH_LINE - 1) / BENCH_LINE;
+  return (Sum == 2u * Moved * (BENCH_LINE - 1)) &&
+         SPSCRing_IsEmpty(&Ring);
+}
+
+int main(void)
+{
+  pthread_t ProducerThread;
+  pthread_t ConsumerThread;
+  bool Passed;
+  double Start;
+
+  if (!CheckEdges() || !Bench())
+  {
+    puts("FAIL");
+    return 1;
+  }
+  SPSCRing_Init(&Ring, Storage, sizeof(Storage));
+  Start = Seconds();
+  pthread_create(&ConsumerThread, NULL, Consumer, &Passed);
+  pthread_create(&ProducerThread, NULL, Producer, NULL);
+  pthread_join(ProducerThread, NULL);
+  pthread_join(ConsumerThread, NULL);
+  fprintf(stdout, "%u bytes through a %u byte ring, %.0f MB/s\n",
+          STRESS_BYTES, (unsigned)sizeof(Storage),
+          STRESS_BYTES / (Seconds() - Start) / 1e6);
+  puts((Passed && SPSCRing_IsEmpty(&Ring)) ? "PASS" : "FAIL");
+  return (Passed && SPSCRing_IsEmpty(&Ring)) ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+/*------------------------------ End of file ------------------------------*/
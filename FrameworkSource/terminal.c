@@ -17,17 +17,34 @@
  -------------- ---     --------
  08/29/20 14:46 ram     first pass
  10/05/20 19:38 ram     starting work on PIC32 port
+ 10/19/26 00:50 mp      Terminal_SimTxInterrupt and Terminal_SimRxInterrupt
+                        take the simulated UART interrupts, so that every
+                        HOST_TEST build uses TxIntResponse and RxIntResponse
+ 10/18/26 20:00 mp      transmit and receive through lock free SPSC rings
+ 10/18/26 18:30 mp      added Terminal_WriteRecord for the binary log. TEST now
+                        selects the harnesses, HOST_TEST only the simulated UART
+ 10/18/26 17:20 mp      receive into a ring from the UART1 RX interrupt, with an
+                        optional line mode that assembles whole command lines
+ 10/18/26 16:10 mp      transmit from the UART1 TX interrupt instead of the
+                        framework idle loop, count dropped bytes. HOST_TEST
+                        builds run the engine against a simulated UART
+ 10/18/26 15:00 mp      added Terminal_Write and _mon_write so that whole
+                        strings go into the TX buffer with one range put,
+                        refill an empty UART FIFO with one range get
  ***************************************************************************/
 
 /*----------------------------- Include Files -----------------------------*/
 
 // Hardware
+#ifndef HOST_TEST
 #include <xc.h>
+#include <sys/attribs.h>    // for ISR macros
+#endif
 #include <stdio.h>
 
 #include "ES_General.h"
 #include "ES_Port.h"
-#include "circular_buffer.h"
+#include "spsc_ring.h"
 #include "dbprintf.h"
 
 //this module
@@ -36,14 +53,76 @@
 #define BAUD_CONST 42 // sets up baud rate for 115200
 //#define BAUD_CONST 21 // sets up baud rate for 230400
 
+// depth of the UART1 transmit FIFO
+#define UART_TX_FIFO_DEPTH 8
+
+// priority of the UART1 interrupt, below the framework tick (3)
+#define TERMINAL_IPL 2
+
+// line mode keeps this many assembled lines, each up to LINE_SLOT_LEN - 1
+// characters long. A line handle stays valid until LINE_SLOTS more lines
+// have been completed
+#define LINE_SLOTS    4
+#define LINE_SLOT_LEN 64
+
+#define BACKSPACE 0x08
+#define DELETE    0x7f
+
 /*---------------------------- Module Functions ---------------------------*/
 /* prototypes for private functions for this service.They should be functions
    relevant to the behavior of this service
 */
+static void TxIntResponse(void);
+static void RxIntResponse(void);
+static void CountDropped(size_t NumDropped);
+
+static bool HW_TxFifoFull(void);
+static bool HW_TxIdle(void);
+static void HW_TxPut(uint8_t txByte);
+static void HW_TxIntEnable(void);
+static void HW_TxIntDisable(void);
+static bool HW_RxAvailable(void);
+static bool HW_RxFrameError(void);
+static uint8_t HW_RxGet(void);
+static bool HW_RxTakeOverrun(void);
 
 /*---------------------------- Module Variables ---------------------------*/
+// the transmit ring is filled by the framework and emptied by the TX
+// interrupt, the receive ring the other way round
 static uint8_t xmitBuffer[XMIT_BUFFER_SIZE];
-static cbuf_handle_t xmitBufferHandle;
+static SPSCRing_t xmitRing;
+
+// number of bytes thrown away because the transmit buffer was full
+static volatile uint32_t xmitOverruns;
+
+static uint8_t recvBuffer[RECV_BUFFER_SIZE];
+static SPSCRing_t recvRing;
+
+// number of received bytes lost, to a full receive buffer or to a hardware
+// FIFO overrun
+static volatile uint32_t recvOverruns;
+
+// line mode assembly
+static bool LineMode = false;
+static char LineSlots[LINE_SLOTS][LINE_SLOT_LEN];
+static uint8_t CurrentSlot;
+static uint8_t LineLength;
+
+#ifdef HOST_TEST
+#include <pthread.h>
+#include <stdatomic.h>
+// simulated UART1 transmitter: the FIFO, the interrupt enable and a lock
+// that keeps the simulated ISR atomic with respect to the enable, as the
+// interrupt controller does on the PIC32
+static uint8_t SimTxFifo[UART_TX_FIFO_DEPTH];
+static uint8_t SimTxCount;
+static atomic_bool SimTxIntEnabled;
+static pthread_mutex_t SimIntLock = PTHREAD_MUTEX_INITIALIZER;
+// simulated receiver
+static const uint8_t *pSimRxBytes;
+static size_t SimRxCount;
+static bool SimRxOverrun;
+#endif
 
 /*------------------------------ Module Code ------------------------------*/
 /*******************************************************************************
@@ -57,6 +136,7 @@ static cbuf_handle_t xmitBufferHandle;
  ******************************************************************************/
 void Terminal_HWInit(void)
 {
+#ifndef HOST_TEST
 //#define USE_RB2_3
 #ifdef USE_RB2_3
   // This was the original pin choice, though we changed this for the project
@@ -92,6 +172,12 @@ void Terminal_HWInit(void)
   U1STA = 0;
   // Set the baud rate based on the constant
   U1BRG = BAUD_CONST;
+  // interrupt while the transmit FIFO is empty, so that the response can
+  // refill all of it, and as soon as a byte is received
+  U1STAbits.UTXISEL = 0b10;
+  U1STAbits.URXISEL = 0b00;
+  IPC8bits.U1IP = TERMINAL_IPL;
+  IFS1CLR = _IFS1_U1TXIF_MASK | _IFS1_U1RXIF_MASK;
   
   // redirect printf to UART1 using X32 built in cross over
   __XC_UART = 1; 
@@ -100,9 +186,18 @@ void Terminal_HWInit(void)
   U1STAbits.UTXEN = 1; // enable transmit 
   U1STAbits.URXEN = 1; // enable receive
   U1MODEbits.ON = 1; // turn peripheral on
+#endif
   
-  // now initialize the circular buffer for transmitting
-  xmitBufferHandle = circular_buf_init( xmitBuffer, ARRAY_SIZE(xmitBuffer) );
+  // now initialize the ring for transmitting. The TX interrupt
+  // stays off until there is something to send
+  SPSCRing_Init(&xmitRing, xmitBuffer, ARRAY_SIZE(xmitBuffer));
+  xmitOverruns = 0;
+  // and the one for receiving, which the RX interrupt fills from now on
+  SPSCRing_Init(&recvRing, recvBuffer, ARRAY_SIZE(recvBuffer));
+  recvOverruns = 0;
+#ifndef HOST_TEST
+  IEC1SET = _IEC1_U1RXIE_MASK;
+#endif
   
   return;
 }
@@ -112,17 +207,16 @@ void Terminal_HWInit(void)
  * Returns byte
  * 
  * Created by: R. Merchant
- * Description: Read the byte from the receive register
+ * Description: Read the next byte from the receive buffer, waiting for one
+ *              if it is empty
  ******************************************************************************/
 uint8_t Terminal_ReadByte(void)
 {
+  uint8_t rxByte;
   // wait for there to be something
-  while(!(U1STAbits.URXDA))
+  while(!SPSCRing_Get(&recvRing, &rxByte))
   {}
-  // if there was an overrun, clear it to reset the unit
-  if(U1STAbits.OERR) U1STAbits.OERR = 0;
-  // return the content of the receive register
-  return U1RXREG;
+  return rxByte;
 }
 /*******************************************************************************
  * Function: Terminal_Write
@@ -141,28 +235,183 @@ void Terminal_WriteByte(uint8_t txByte)
   // write the byte to the register
   U1TXREG = txByte;
 #else
-  circular_buf_put(xmitBufferHandle, txByte);
+  if (!SPSCRing_Put(&xmitRing, txByte))
+  {
+    CountDropped(1);
+  }
+  HW_TxIntEnable();
+#endif  
+  return;
+}
+/*******************************************************************************
+ * Function: Terminal_Write
+ * Arguments: pointer to the bytes to write, number of bytes
+ * Returns nothing
+ * 
+ * Created by: M. Peraza
+ * Description: Writes a block of bytes to the transmit buffer with a single
+ *              range put. Bytes that do not fit in the buffer are dropped
+ *              and counted
+ ******************************************************************************/
+void Terminal_Write(const uint8_t *pBytes, size_t Count)
+{
+#ifdef NO_BUFFER
+  while (Count-- > 0)
+  {
+    Terminal_WriteByte(*pBytes++);
+  }
+#else
+  CountDropped(Count - SPSCRing_PutRange(&xmitRing, pBytes, Count));
+  HW_TxIntEnable();
 #endif  
   return;
 }
+
+/*******************************************************************************
+ * Function: Terminal_WriteRecord
+ * Arguments: pointer to the record, number of bytes in it
+ * Returns true if the record was queued
+ * 
+ * Created by: M. Peraza
+ * Description: Writes a binary record to the transmit buffer only if all of it
+ *              fits, so that the host never sees part of a record. A record
+ *              that does not fit is dropped and its bytes counted
+ ******************************************************************************/
+bool Terminal_WriteRecord(const uint8_t *pBytes, size_t Count)
+{
+#ifdef NO_BUFFER
+  Terminal_Write(pBytes, Count);
+  return true;
+#else
+  // only the TX interrupt takes bytes out, so the room can not shrink
+  // between this check and the put
+  if (SPSCRing_Free(&xmitRing) < Count)
+  {
+    CountDropped(Count);
+    return false;
+  }
+  SPSCRing_PutRange(&xmitRing, pBytes, Count);
+  HW_TxIntEnable();
+  return true;
+#endif
+}
+
+/*******************************************************************************
+ * Function: Terminal_GetTxOverruns
+ * Arguments: none
+ * Returns the number of bytes dropped
+ * 
+ * Created by: M. Peraza
+ * Description: Returns how many output bytes have been thrown away because
+ *              the transmit buffer was full since Terminal_HWInit
+ ******************************************************************************/
+uint32_t Terminal_GetTxOverruns(void)
+{
+  return xmitOverruns;
+}
 /*******************************************************************************
  * Function: Terminal_IsRxData
  * Arguments: none
  * Returns status
  * 
  * Created by: R. Merchant
- * Description: Returns true if there is data in the receive register, or false
+ * Description: Returns true if there is data in the receive buffer, or false
  *              if not
  ******************************************************************************/
 bool Terminal_IsRxData(void)
 {
-  
-    if(U1STAbits.FERR != 0 ){
-        U1RXREG; // in case of a framing error, read the data reg to clear err
-        return false;
+    return !SPSCRing_IsEmpty(&recvRing);
+}
+
+/*******************************************************************************
+ * Function: Terminal_GetRxOverruns
+ * Arguments: none
+ * Returns the number of received bytes lost
+ * 
+ * Created by: M. Peraza
+ * Description: Returns how many received bytes have been lost, because the
+ *              receive buffer was full or the UART FIFO overran, since
+ *              Terminal_HWInit
+ ******************************************************************************/
+uint32_t Terminal_GetRxOverruns(void)
+{
+  return recvOverruns;
+}
+
+/*******************************************************************************
+ * Function: Terminal_SetLineMode
+ * Arguments: true for line mode, false for single key mode
+ * Returns none
+ * 
+ * Created by: M. Peraza
+ * Description: In line mode the key stroke checker collects whole lines with
+ *              Terminal_GetNewLine rather than reporting each key. Any
+ *              partly assembled line is discarded on a change
+ ******************************************************************************/
+void Terminal_SetLineMode(bool NewLineMode)
+{
+  LineMode = NewLineMode;
+  LineLength = 0;
+}
+
+bool Terminal_IsLineMode(void)
+{
+  return LineMode;
+}
+
+/*******************************************************************************
+ * Function: Terminal_GetNewLine
+ * Arguments: where to return the handle of a completed line
+ * Returns true if a line was completed
+ * 
+ * Created by: M. Peraza
+ * Description: Moves received bytes into the current line until a CR or LF
+ *              ends it. Backspace and delete remove the last character,
+ *              characters past the end of the slot are dropped and empty
+ *              lines (the LF of a CR LF pair) are skipped
+ ******************************************************************************/
+bool Terminal_GetNewLine(uint16_t *pHandle)
+{
+  uint8_t rxByte;
+
+  while (SPSCRing_Get(&recvRing, &rxByte))
+  {
+    if ((rxByte == '\r') || (rxByte == '\n'))
+    {
+      if (LineLength != 0)
+      {
+        LineSlots[CurrentSlot][LineLength] = '\0';
+        *pHandle = CurrentSlot;
+        CurrentSlot = (CurrentSlot + 1) % LINE_SLOTS;
+        LineLength = 0;
+        return true;
+      }
     }
-    // Return Rx Data bit from status register
-    return U1STAbits.URXDA;
+    else if ((rxByte == BACKSPACE) || (rxByte == DELETE))
+    {
+      if (LineLength != 0)
+      {
+        LineLength--;
+      }
+    }
+    else if (LineLength < (LINE_SLOT_LEN - 1))
+    {
+      LineSlots[CurrentSlot][LineLength++] = rxByte;
+    }
+  }
+  return false;
+}
+
+/*******************************************************************************
+ * Function: Terminal_GetLine
+ * Arguments: handle from an ES_NEW_LINE event
+ * Returns the null terminated line
+ * 
+ * Created by: M. Peraza
+ ******************************************************************************/
+const char *Terminal_GetLine(uint16_t Handle)
+{
+  return LineSlots[Handle % LINE_SLOTS];
 }
 
 /*******************************************************************************
@@ -177,7 +426,22 @@ bool Terminal_IsRxData(void)
  ******************************************************************************/
 void _mon_putc (char c)
 {
-  circular_buf_put(xmitBufferHandle, c);
+  Terminal_WriteByte(c);
+}
+
+/*******************************************************************************
+ * Function: _mon_write
+ * Arguments: pointer to the characters, number of characters
+ * Returns none
+ * 
+ * Created by: M. Peraza
+ * Description: replaces the library version, which calls _mon_putc once per
+ *              character, so that the output of printf() and puts() goes
+ *              into the circular buffer as a block.
+ ******************************************************************************/
+void _mon_write (const char * s, unsigned int count)
+{
+  Terminal_Write((const uint8_t *)s, count);
 }
 
 /*******************************************************************************
@@ -190,17 +454,58 @@ void _mon_putc (char c)
  *              circular buffer and stuffs them into the UART1 buffer
  *              until we either run out of bytes in the circular buffer
  *              or we run out of space in the UART FIFO
+ * Notes: normally the TX interrupt does this. Polling is only for when
+ *        interrupts are off, as in _fassert, since the buffer can only have
+ *        one reader at a time
  ******************************************************************************/
 void Terminal_MoveBuffer2UART( void )
 {
-  while ( (!circular_buf_empty(xmitBufferHandle)) && (!U1STAbits.UTXBF))
+  // when the transmitter is completely idle the whole FIFO is free, so fill
+  // it from a single range get without testing UTXBF between bytes
+  if (HW_TxIdle())
+  {
+    uint8_t bytes2Xmit[UART_TX_FIFO_DEPTH];
+    size_t numBytes;
+    size_t i;
+    numBytes = SPSCRing_GetRange(&xmitRing, bytes2Xmit, UART_TX_FIFO_DEPTH);
+    for (i = 0; i < numBytes; i++)
+    {
+      HW_TxPut(bytes2Xmit[i]);
+    }
+  }
+  while ( (!SPSCRing_IsEmpty(&xmitRing)) && (!HW_TxFifoFull()))
   {
     uint8_t byte2Xmit;
-    circular_buf_get(xmitBufferHandle, &byte2Xmit);
-    U1TXREG = byte2Xmit;
+    SPSCRing_Get(&xmitRing, &byte2Xmit);
+    HW_TxPut(byte2Xmit);
+  }
+}
+
+#ifndef HOST_TEST
+/*******************************************************************************
+ * Function: Terminal_UART1IntHandler
+ * Arguments: none
+ * Returns none
+ * 
+ * Created by: M. Peraza
+ * Description: UART1 interrupt response. Empties the receive FIFO into the
+ *              receive buffer and refills the transmit FIFO from the
+ *              transmit buffer whenever it empties
+ ******************************************************************************/
+void __ISR(_UART_1_VECTOR, IPL2AUTO) Terminal_UART1IntHandler(void)
+{
+  if (IFS1bits.U1RXIF)
+  {
+    RxIntResponse();
+  }
+  if (IFS1bits.U1TXIF && IEC1bits.U1TXIE)
+  {
+    TxIntResponse();
   }
 }
+#endif
 
+#ifndef HOST_TEST
 void __attribute__((noreturn)) _fassert(int nLineNumber,
                                         const char * sFileName,
                                         const char * sFailedExpression,
@@ -208,17 +513,243 @@ void __attribute__((noreturn)) _fassert(int nLineNumber,
 {
   DB_printf("Assert \"%s\" Failed at Line: %d, in File: %s \n\r", 
             sFailedExpression, nLineNumber, sFileName, sFunction);
-    // now pump the bytes out of the buffer into the UART
+    // take over from the TX interrupt and pump the bytes out of the buffer
+    // into the UART
+    __builtin_disable_interrupts();
     while(1) 
     {
         Terminal_MoveBuffer2UART();
     }
 }
+#endif
 /***************************************************************************
  private functions
  ***************************************************************************/
+// moves the next FIFO's worth of bytes from the circular buffer into the
+// UART, and turns the interrupt off once the buffer has been emptied. A
+// writer that adds bytes after this turns it back on.
+static void TxIntResponse(void)
+{
+  uint8_t bytes2Xmit[UART_TX_FIFO_DEPTH];
+  size_t numBytes;
+  size_t i;
+
+  // the interrupt is only requested while the FIFO is empty, so all of it
+  // is free
+  numBytes = SPSCRing_GetRange(&xmitRing, bytes2Xmit, UART_TX_FIFO_DEPTH);
+  for (i = 0; i < numBytes; i++)
+  {
+    HW_TxPut(bytes2Xmit[i]);
+  }
+  if (numBytes == 0)
+  {
+    HW_TxIntDisable();
+  }
+#ifndef HOST_TEST
+  // the flag stays set while the FIFO is empty, so clear it after the refill
+  IFS1CLR = _IFS1_U1TXIF_MASK;
+#endif
+}
+
+// moves everything in the receive FIFO into the receive buffer. Bytes with
+// a framing error are thrown away, bytes that will not fit are counted as
+// lost, as is a FIFO overrun, which also has to be cleared before the UART
+// will receive again
+static void RxIntResponse(void)
+{
+  uint8_t rxByte;
+  bool    frameError;
+
+  while (HW_RxAvailable())
+  {
+    frameError = HW_RxFrameError();
+    rxByte = HW_RxGet();
+    if (!frameError && !SPSCRing_Put(&recvRing, rxByte))
+    {
+      recvOverruns++;
+    }
+  }
+  if (HW_RxTakeOverrun())
+  {
+    recvOverruns++;
+  }
+#ifndef HOST_TEST
+  IFS1CLR = _IFS1_U1RXIF_MASK;
+#endif
+}
+
+static void CountDropped(size_t NumDropped)
+{
+  if (NumDropped != 0)
+  {
+    EnterCritical();
+    xmitOverruns += NumDropped;
+    ExitCritical();
+  }
+}
+
+#ifndef HOST_TEST
+static bool HW_TxFifoFull(void)
+{
+  return U1STAbits.UTXBF;
+}
+
+static bool HW_TxIdle(void)
+{
+  return U1STAbits.TRMT;
+}
+
+static void HW_TxPut(uint8_t txByte)
+{
+  U1TXREG = txByte;
+}
+
+static void HW_TxIntEnable(void)
+{
+  IEC1SET = _IEC1_U1TXIE_MASK;
+}
+
+static void HW_TxIntDisable(void)
+{
+  IEC1CLR = _IEC1_U1TXIE_MASK;
+}
+
+static bool HW_RxAvailable(void)
+{
+  return U1STAbits.URXDA;
+}
+
+static bool HW_RxFrameError(void)
+{
+  return U1STAbits.FERR;
+}
+
+static uint8_t HW_RxGet(void)
+{
+  return U1RXREG;
+}
+
+// clears a receive overrun, returns true if there was one
+static bool HW_RxTakeOverrun(void)
+{
+  if (U1STAbits.OERR)
+  {
+    U1STACLR = _U1STA_OERR_MASK;
+    return true;
+  }
+  return false;
+}
+
+#else // HOST_TEST
+static bool HW_TxFifoFull(void)
+{
+  return SimTxCount == UART_TX_FIFO_DEPTH;
+}
+
+static bool HW_TxIdle(void)
+{
+  return SimTxCount == 0;
+}
+
+static void HW_TxPut(uint8_t txByte)
+{
+  SimTxFifo[SimTxCount++] = txByte;
+}
+
+static void HW_TxIntEnable(void)
+{
+  // a real enable cannot land in the middle of the ISR
+  pthread_mutex_lock(&SimIntLock);
+  atomic_store(&SimTxIntEnabled, true);
+  pthread_mutex_unlock(&SimIntLock);
+}
+
+static void HW_TxIntDisable(void)
+{
+  atomic_store(&SimTxIntEnabled, false);
+}
+
+static bool HW_RxAvailable(void)
+{
+  return SimRxCount != 0;
+}
+
+static bool HW_RxFrameError(void)
+{
+  return false;
+}
+
+static uint8_t HW_RxGet(void)
+{
+  SimRxCount--;
+  return *pSimRxBytes++;
+}
+
+static bool HW_RxTakeOverrun(void)
+{
+  bool overrun = SimRxOverrun;
+  SimRxOverrun = false;
+  return overrun;
+}
+
+/*******************************************************************************
+ * Function: Terminal_SimDrain
+ * Arguments: where to put the bytes, most bytes to take
+ * Returns the number of bytes taken
+ * 
+ * Created by: M. Peraza
+ * Description: Host builds only: takes bytes straight out of the transmit
+ *              buffer, for harnesses that do not run the simulated UART
+ ******************************************************************************/
+size_t Terminal_SimDrain(uint8_t *pBytes, size_t MaxBytes)
+{
+  return SPSCRing_GetRange(&xmitRing, pBytes, MaxBytes);
+}
+
+/*******************************************************************************
+ * Function: Terminal_SimTxInterrupt
+ * Arguments: none
+ * Returns true if the interrupt was enabled and so was taken
+ * 
+ * Created by: M. Peraza
+ * Description: Host builds only: the UART1 TX interrupt for the simulated
+ *              UART, refills the simulated FIFO from the transmit buffer.
+ *              Call it when that FIFO is empty, as the hardware would
+ ******************************************************************************/
+bool Terminal_SimTxInterrupt(void)
+{
+  bool taken;
+
+  pthread_mutex_lock(&SimIntLock);
+  taken = atomic_load(&SimTxIntEnabled);
+  if (taken)
+  {
+    TxIntResponse();
+  }
+  pthread_mutex_unlock(&SimIntLock);
+  return taken;
+}
+
+/*******************************************************************************
+ * Function: Terminal_SimRxInterrupt
+ * Arguments: the bytes received, how many, whether the FIFO overran
+ * Returns nothing
+ * 
+ * Created by: M. Peraza
+ * Description: Host builds only: puts the bytes in the simulated receiver
+ *              and takes the UART1 RX interrupt
+ ******************************************************************************/
+void Terminal_SimRxInterrupt(const uint8_t *pBytes, size_t Count, bool Overrun)
+{
+  pSimRxBytes = pBytes;
+  SimRxCount = Count;
+  SimRxOverrun = Overrun;
+  RxIntResponse();
+}
+#endif // HOST_TEST
+
 // module test harness:
-#ifdef TEST
+#if defined(TEST) && !defined(HOST_TEST)
 int main(void)
 {
   
@@ -230,6 +761,7 @@ int main(void)
   //Terminal_WriteByte('H');
   while(1) //hang out in this loop forever, polling key hits
   {
+    // interrupts are never turned on here, so poll
     Terminal_MoveBuffer2UART(); // move bytes from circ buffer to UART
     // a delay loop to let me see that the buffering is working as expected.
     { volatile uint32_t counter;
@@ -246,6 +778,144 @@ int main(void)
   }
   return 0;
 }
-#endif
+#endif // TEST && !HOST_TEST
+
+/***************************************************************************
+ host test harness, checks line assembly from the simulated receiver, then
+ that bytes leave the simulated UART in the order they were accepted while
+ a writer and the TX interrupt run concurrently
+ gcc -c -IFrameworkHeaders FrameworkSource/spsc_ring.c
+ gcc -DTEST -DHOST_TEST -pthread -IFrameworkHeaders -IProjectHeaders \
+     FrameworkSource/terminal.c spsc_ring.o -o terminal_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <string.h>
+#include <sched.h>
+
+#define SIM_LINES     50000
+#define SIM_LINE_LEN  24
+
+static uint8_t Accepted[SIM_LINES * SIM_LINE_LEN];
+static size_t NumAccepted;
+static uint8_t Wire[SIM_LINES * SIM_LINE_LEN];
+static size_t NumOnWire;
+static atomic_bool WriterDone;
+
+// the UART and its interrupt: shift the FIFO out to the wire and take the
+// interrupt whenever the FIFO is empty and the interrupt is enabled
+static void *SimUARTThread(void *pArg)
+{
+  bool done;
+
+  (void)pArg;
+  while (1)
+  {
+    if (SimTxCount > 0)
+    {
+      Wire[NumOnWire++] = SimTxFifo[0];
+      memmove(SimTxFifo, SimTxFifo + 1, --SimTxCount);
+      continue;
+    }
+    // done is read first: once the writer is done, a disabled interrupt
+    // means that everything it wrote has gone
+    done = atomic_load(&WriterDone);
+    if (!Terminal_SimTxInterrupt() && done)
+    {
+      break;
+    }
+  }
+  return NULL;
+}
+
+// feeds bytes to the simulated receiver and takes the RX interrupt
+static void SimReceive(const char *pBytes, bool overrun)
+{
+  Terminal_SimRxInterrupt((const uint8_t *)pBytes, strlen(pBytes), overrun);
+}
+
+static bool CheckLineMode(void)
+{
+  static const char * const Expected[] = { "help", "set  7", "abc" };
+  uint16_t handle;
+  uint8_t numLines = 0;
+  bool passed = true;
+
+  Terminal_SetLineMode(true);
+  SimReceive("help\r\nset 5\b 7\rab", false);
+  SimReceive("c\nunfinished", true);
+  while (Terminal_GetNewLine(&handle))
+  {
+    if ((numLines >= 3) || strcmp(Terminal_GetLine(handle), Expected[numLines]))
+    {
+      passed = false;
+    }
+    numLines++;
+  }
+  if ((numLines != 3) || (Terminal_GetRxOverruns() != 1))
+  {
+    passed = false;
+  }
+  // an over long line is cut to fit the slot
+  SimReceive(" and the rest of a line that is far too long to fit in a slot\r",
+      false);
+  if (!Terminal_GetNewLine(&handle) ||
+      (strlen(Terminal_GetLine(handle)) != LINE_SLOT_LEN - 1))
+  {
+    passed = false;
+  }
+  Terminal_SetLineMode(false);
+  fprintf(stdout, "line mode: %s\n", passed ? "ok" : "wrong");
+  return passed;
+}
+
+int main(void)
+{
+  pthread_t uart;
+  uint8_t line[SIM_LINE_LEN];
+  uint32_t i;
+  uint32_t dropped;
+  size_t numPut;
+
+  Terminal_HWInit();
+  if (!CheckLineMode())
+  {
+    puts("FAIL");
+    return 1;
+  }
+  pthread_create(&uart, NULL, SimUARTThread, NULL);
+
+  // the writer, standing in for the framework, keeps track of what the
+  // buffer accepted so that it can be compared with the wire. For the first
+  // half it waits for room, as a lightly loaded system would, for the
+  // second half it writes flat out and overruns the buffer
+  for (i = 0; i < SIM_LINES; i++)
+  {
+    while ((i < SIM_LINES / 2) &&
+        (SPSCRing_Count(&xmitRing) + SIM_LINE_LEN > XMIT_BUFFER_SIZE))
+    {
+      sched_yield();
+    }
+    snprintf((char *)line, sizeof(line), "line %10u .......", i);
+    dropped = Terminal_GetTxOverruns();
+    Terminal_Write(line, SIM_LINE_LEN);
+    numPut = SIM_LINE_LEN - (Terminal_GetTxOverruns() - dropped);
+    memcpy(&Accepted[NumAccepted], line, numPut);
+    NumAccepted += numPut;
+  }
+  atomic_store(&WriterDone, true);
+  pthread_join(uart, NULL);
+
+  fprintf(stdout, "%zu bytes accepted, %u dropped, %zu on the wire\n",
+      NumAccepted, Terminal_GetTxOverruns(), NumOnWire);
+  if ((NumOnWire != NumAccepted) || (memcmp(Wire, Accepted, NumAccepted) != 0) ||
+      (NumAccepted + Terminal_GetTxOverruns() != SIM_LINES * SIM_LINE_LEN))
+  {
+    puts("FAIL");
+    return 1;
+  }
+  puts("PASS");
+  return 0;
+}
+#endif // TEST && HOST_TEST
 /*------------------------------- Footnotes -------------------------------*/
 /*------------------------------ End of file ------------------------------*/
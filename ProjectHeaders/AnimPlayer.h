@@ -0,0 +1,58 @@
+/****************************************************************************
+ Module
+     AnimPlayer.h
+
+ Description
+     Plays frame sequences kept compressed in flash onto a compositor layer,
+     one frame for each step. Tools/encode_anim.py makes the sequences from
+     text or PBM frames and writes them to ProjectSource/Animations.c.
+
+ Notes
+     A sequence is one record after another, a record for each frame:
+       a byte with a bit for each row (bit 0 the top row) that is different
+       from the frame before, then each of those rows, top first, run length
+       encoded: a byte n below 0x80 is followed by n + 1 bytes as they are,
+       a byte 0x80 + n by 1 byte to repeat n + 1 times.
+     A row is Width bytes, the left module first with its left column in
+     bit 7. The first frame has every row, so the sequence can loop.
+     Rows that did not change cost a bit and are not touched, so each step
+     rebuilds only the rows the frame changes. The player keeps no copy of
+     the frame, only its place in the sequence.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 23:58 mp      first pass
+*****************************************************************************/
+#ifndef ANIMPLAYER_H
+#define ANIMPLAYER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Compositor.h"
+
+typedef struct
+{
+  const uint8_t *pData;   // the encoded frames
+  uint16_t NumFrames;
+  uint16_t PeriodMs;      // time for each frame
+  int16_t  Column;        // display column for the left end
+  uint8_t  Width;         // in modules, 8 columns each
+} Anim_t;
+
+// the sequences in Animations.c, in the order given to encode_anim.py
+typedef enum
+{
+  AnimIdle = 0,
+  NUM_ANIMATIONS
+} AnimId_t;
+
+extern const Anim_t * const Animations[NUM_ANIMATIONS];
+
+void Anim_Start(const Anim_t *pAnim, CompLayer_t Layer, bool Loop);
+bool Anim_Step(void);
+void Anim_Stop(void);
+bool Anim_IsRunning(void);
+uint16_t Anim_GetPeriod(void);
+
+#endif /* ANIMPLAYER_H */
@@ -0,0 +1,54 @@
+/****************************************************************************
+ Module
+     Compositor.h
+
+ Description
+     Combines several 1 bit layers, each the size of the display, into the
+     display buffer, so that the instruction text, the score and effects
+     such as blinking can be drawn without overwriting each other.
+
+ Notes
+     Layers are drawn from the bottom (CompLayerText) up. Each layer has a
+     column and row offset, can be hidden, and goes onto the layers below
+     it with OR (draws), AND (masks) or XOR (inverts), a word at a time.
+     A layer keeps its own pixels and a cached copy moved to its offset;
+     drawing on a layer or moving it only redoes that layer's copy, and
+     Comp_Compose only rebuilds the rows where a copy changed. The caller
+     commits the frame after Comp_Compose.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 23:50 mp      first pass
+*****************************************************************************/
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "DM_Display.h"
+
+// the layers, bottom first
+typedef enum
+{
+  CompLayerText = 0,  // instructions and messages, the marquee
+  CompLayerScore,     // score and status
+  CompLayerEffect,    // blink and idle animations
+  COMP_NUM_LAYERS
+} CompLayer_t;
+
+// how a layer goes onto the layers below it
+typedef enum { CompOpOr = 0, CompOpAnd, CompOpXor } CompOp_t;
+
+void Comp_Init(void);
+void Comp_ClearLayer(CompLayer_t Layer);
+void Comp_DrawString(CompLayer_t Layer, const unsigned char *pString,
+                     DM_Align_t Align);
+bool Comp_PutLayerRow(CompLayer_t Layer, const uint32_t *pWords,
+                      uint8_t WhichRow);
+void Comp_SetOffset(CompLayer_t Layer, int16_t Cols, int8_t Rows);
+void Comp_SetVisible(CompLayer_t Layer, bool Visible);
+void Comp_SetOp(CompLayer_t Layer, CompOp_t Op);
+uint8_t Comp_Compose(void);
+
+#endif /* COMPOSITOR_H */
@@ -8,32 +8,47 @@
 #ifndef DM_DISPLAY_H
 #define	DM_DISPLAY_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "DisplayTx.h"
+
+// the display is a row of 8 x 8 modules, one for each controller in the
+// chain, module 0 at the right end. A row of the display buffer is
+// DM_ROW_WORDS 32 bit words, module 0 in the low byte of word 0
+#define DM_NUM_MODULES  DISPLAY_CHAIN_LEN
+#define DM_ROW_WORDS    ((DM_NUM_MODULES + 3) / 4)
+
+// where DM_RenderString puts a string that is shorter than the display
+typedef enum { DM_AlignLeft = 0, DM_AlignRight, DM_AlignCenter } DM_Align_t;
+
 /****************************************************************************
  Function
-  DM_TakeInitDisplayStep
+  DM_StartInitDisplay
 
  Parameter
   None
 
  Returns
-  bool: true when there are no more initialization steps to perform; false
-        while there still more steps to be taken
+  bool: true when the whole initialization was queued; false if the display
+        transmitter was already too busy to take it
 
  Description
-  Initializes the MAX7219 4-module display performing 1 step for each call:
-    First, bring put it in shutdown to disable all displays, return false
-    Next fill the display RAM with Zeros to insure blanked, return false
-    Then Disable Code B decoding for all digits, return false
-    Then, enable scanning for all digits, return false
-    The next setup step is to set the brightness to minimum, return false
-    Copy our display buffer to the display, return false
-    Finally, bring it out of shutdown and return true
+  Queues the initialization of the MAX7219 display with the display
+  transmitter (DisplayTx.h) and returns without waiting:
+    First, bring put it in shutdown to disable all displays
+    Next fill the display RAM with Zeros to insure blanked
+    Then Disable Code B decoding for all digits
+    Then, enable scanning for all digits
+    The next setup step is to set the brightness to minimum
+    Copy our display buffer to the display
+    Finally, bring it out of shutdown
+  DisplayTx_Init must have been called first.
    
 Example
-   while ( false == DM_TakeInitDisplayStep() )
-   {} // note this example is for non-event-driven code
+   DisplayTx_Init();
+   DM_StartInitDisplay();
 ****************************************************************************/
-bool DM_TakeInitDisplayStep( void );
+bool DM_StartInitDisplay( void );
 
 
 /****************************************************************************
@@ -75,23 +90,50 @@ void DM_ScrollDisplayBuffer( uint8_t NumCols2Scroll);
 
 /****************************************************************************
  Function
-  DM_TakeDisplayUpdateStep
+  DM_CommitFrame
 
  Parameter
   None
 
  Returns
-  bool: true when all rows have been copied to the display; false otherwise
+  uint8_t: one bit for each row that is different from the last frame
 
  Description
-  Copies the contents of the display buffer to the MAX7219 controllers 1 row
-  per call.
+  Makes the display buffer the next frame to be shown. Only the rows that
+  changed since the last commit are sent by DM_StartDisplayUpdate. The
+  display buffer is left as it is, ready to be drawn on again.
    
 Example
-   while (false == DM_TakeDisplayUpdateStep())
-   {} // note this example is for non-event-driven code
+   DM_AddString2Display(Instruction);
+   DM_CommitFrame();
 ****************************************************************************/
-bool DM_TakeDisplayUpdateStep( void );
+uint8_t DM_CommitFrame( void );
+
+/****************************************************************************
+ Function
+  DM_StartDisplayUpdate
+
+ Parameter
+  None
+
+ Returns
+  bool: true when ES_DISPLAY_DONE will follow, because rows were queued or
+        the transmitter is still sending; false when there was nothing to do
+
+ Description
+  Queues the rows of the committed frame that changed with the display
+  transmitter and returns without waiting for them to go out. A row that
+  does not fit in the transmitter's queue stays marked, so call it again
+  on ES_DISPLAY_DONE.
+   
+Example
+   DM_CommitFrame();
+   if (DM_StartDisplayUpdate())
+   {
+     CurrentState = Display; // until ES_DISPLAY_DONE
+   }
+****************************************************************************/
+bool DM_StartDisplayUpdate( void );
 
 
 /****************************************************************************
@@ -114,25 +156,74 @@ Example
 void DM_AddChar2Display( unsigned char Char2Display);
 void DM_AddString2Display( unsigned char* String2Display);
 
+/****************************************************************************
+ Function
+  DM_RenderString
+
+ Parameter
+  const unsigned char *: The string to be drawn
+  DM_Align_t: Where to put it when it is shorter than the display
+  
+ Returns
+  Nothing (void)
+
+ Description
+  Draws the string into the frame buffer in one pass, 4 columns per
+  character. Characters beyond the ends of the display are clipped; with
+  DM_AlignRight the end of a long string is kept, as DM_AddString2Display
+  does. The string is ORed into the buffer, so clear it first to replace
+  what is there.
+   
+Example
+   DM_ClearDisplayBuffer();
+   DM_RenderString((const unsigned char *)"READY", DM_AlignCenter);
+****************************************************************************/
+void DM_RenderString( const unsigned char *pString, DM_Align_t Align);
+
+/****************************************************************************
+ Function
+  DM_RenderStringInto
+
+ Parameter
+  uint32_t [][DM_ROW_WORDS]: 8 rows laid out like the frame buffer
+  const unsigned char *: The string to be drawn
+  DM_Align_t: Where to put it when it is shorter than the display
+
+ Returns
+  Nothing (void)
+
+ Description
+  DM_RenderString, drawing into the given rows instead of the frame buffer.
+  The compositor (Compositor.h) draws its layers with it.
+
+Example
+   uint32_t Rows[8][DM_ROW_WORDS] = { { 0 } };
+   DM_RenderStringInto(Rows, (const unsigned char *)"12", DM_AlignRight);
+****************************************************************************/
+void DM_RenderStringInto( uint32_t pRows[][DM_ROW_WORDS],
+                          const unsigned char *pString, DM_Align_t Align);
+
 /****************************************************************************
  Function
   DM_PutDataIntoBufferRow
 
  Parameter
-  uint32_t: The new row data to be stored in the display buffer
+  const uint32_t *: The DM_ROW_WORDS words of new row data to be stored in
+                    the display buffer
   uint8_t:  The row (0->7) into which the data will be stored.
   
  Returns
   bool: true for a legal row number; false otherwise
 
  Description
-  Copies the raw data from the Data2Insert parameter into the specified row 
+  Copies the raw data from pData2Insert into the specified row 
   of the frame buffer 
    
 Example
-   DM_PutDataInBufferRow(0x00000001, 0);
+   uint32_t RowData[DM_ROW_WORDS] = { 0x00000001 };
+   DM_PutDataIntoBufferRow(RowData, 0);
 ****************************************************************************/
-bool DM_PutDataIntoBufferRow( uint64_t Data2Insert, uint8_t WhichRow);
+bool DM_PutDataIntoBufferRow( const uint32_t *pData2Insert, uint8_t WhichRow);
 
 /****************************************************************************
  Function
@@ -140,7 +231,7 @@ bool DM_PutDataIntoBufferRow( uint64_t Data2Insert, uint8_t WhichRow);
 
  Parameter
   uint8_t: The row of the display buffer to be queried
-  uint32_t *: pointer to variable to hold the data from the buffer 
+  uint32_t *: pointer to DM_ROW_WORDS words to hold the data from the buffer 
   
  Returns
   bool: true for a legal row number; false otherwise
@@ -150,9 +241,10 @@ bool DM_PutDataIntoBufferRow( uint64_t Data2Insert, uint8_t WhichRow);
  location pointed to by pReturnValue
    
 Example
-   DM_QueryRowData(0,&ReturnedValue);
+   uint32_t ReturnedValue[DM_ROW_WORDS];
+   DM_QueryRowData(0, ReturnedValue);
 ****************************************************************************/
-bool DM_QueryRowData( uint8_t RowToQuery, uint64_t * pReturnValue);
+bool DM_QueryRowData( uint8_t RowToQuery, uint32_t * pReturnValue);
 
 #endif	/* DM_DISPLAY_H */
 
@@ -0,0 +1,53 @@
+/****************************************************************************
+ Module
+     DisplayTx.h
+
+ Description
+     Interrupt driven SPI1 transmitter for the MAX7219 chain. A latch is one
+     16 bit word for each controller in the chain; the words of a latch are
+     shifted out back to back and take effect together when SS rises.
+
+ Notes
+     DisplayTx_QueueLatch returns straight away. The first latch is written
+     to the SPI1 FIFO there and then, each following one from the INT4
+     interrupt on the rising edge of SS that ends the one before. When the
+     queue runs dry DisplayTx_CheckDone reports it once, for the event
+     checker that posts ES_DISPLAY_DONE; the interrupt does not post itself
+     because the framework's post functions are not safe to call from one.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 23:20 mp      chains longer than the SPI1 FIFO
+ 10/18/26 22:20 mp      first pass
+*****************************************************************************/
+#ifndef DISPLAYTX_H
+#define DISPLAYTX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// controllers in the chain, one word each per latch, up to 32. Latches
+// longer than the SPI1 enhanced buffer (8 words) are topped up from the
+// SPI1 transmit interrupt
+#ifndef DISPLAY_CHAIN_LEN
+#define DISPLAY_CHAIN_LEN   8
+#endif
+// latches the queue holds. A full display update with the init commands
+// is 13
+#define DISPLAY_TX_LATCHES  16
+
+void DisplayTx_Init(void);
+bool DisplayTx_QueueLatch(const uint16_t *pWords);
+bool DisplayTx_IsBusy(void);
+bool DisplayTx_CheckDone(void);
+
+#ifdef HOST_TEST
+// host builds: the test supplies the SPI1 data register and calls the SS
+// rise and transmit interrupt responses
+void DisplayTx_SimWrite(uint16_t Word);
+void DisplayTx_SimSSRise(void);
+void DisplayTx_SimTxInt(void);
+#endif
+
+#endif /* DISPLAYTX_H */
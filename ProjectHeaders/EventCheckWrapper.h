@@ -9,6 +9,7 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 00:05 mp       added ES_ShortTimer.h for ES_ShortTimer_CheckExpired
  12/19/16 20:12 jec      Started coding
 *****************************************************************************/
 
@@ -19,6 +20,8 @@
 #include "EventCheckers.h"
 #include "SensorService.h"
 #include "VibrationFSM.h"
+#include "LEDService.h"
+#include "ES_ShortTimer.h"
 
 // Here you would #include the header files for any other modules that
 // contained event checking functions
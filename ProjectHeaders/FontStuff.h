@@ -12,7 +12,16 @@
 extern "C" {
 #endif
 
+// font4x6 expanded by Tools/gen_font_glyphs.py into FontGlyphs.c, one byte
+// per display row with the pixels in the same bits as getFontLine returns
+#define FONT_FIRST_CHAR  32
+#define FONT_NUM_GLYPHS  96
+#define FONT_GLYPH_ROWS  8
+
+extern const uint8_t FontGlyphs[FONT_NUM_GLYPHS][FONT_GLYPH_ROWS];
+
 uint8_t getFontLine(unsigned char data, int line_num);
+const uint8_t *getFontGlyph(unsigned char data);
 
 
 #ifdef	__cplusplus
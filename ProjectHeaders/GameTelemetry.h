@@ -0,0 +1,62 @@
+/****************************************************************************
+ Module
+     GameTelemetry.h
+
+ Description
+     Per-round telemetry records for game mode, sent over the terminal UART
+     for Tools/telemetry_stats.py to collect.
+
+ Notes
+     A record is
+       TELEM_SYNC, length (of type, session and payload), type,
+       session (2 bytes, LS byte first), payload,
+       CRC-8 of the length, type, session and payload (as ES_Inject_CRC8)
+     with these payloads, multi-byte fields LS byte first
+       TELEM_GAME_START  none
+       TELEM_ROUND       round, module, outcome, reaction time (2 bytes, ms)
+       TELEM_GAME_END    rounds, points (2 bytes), game length (2 bytes, ms)
+     Records go into the transmit buffer whole or not at all and never wait
+     for room; a record that does not fit is dropped and counted in
+     Terminal_GetTxOverruns. Define GAME_TELEMETRY in ES_Configure.h to turn
+     the records on.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 21:40 mp      first pass
+*****************************************************************************/
+#ifndef GAMETELEMETRY_H
+#define GAMETELEMETRY_H
+
+#include "ES_Configure.h"
+#include "ES_Types.h"
+
+// not ASCII and not DB_LOG_SYNC, so records can share the UART with both
+#define TELEM_SYNC 0xA6
+
+#define TELEM_GAME_START  1
+#define TELEM_ROUND       2
+#define TELEM_GAME_END    3
+
+// how a round ended
+typedef enum
+{
+  RoundHit,         // the lit module was triggered
+  RoundTimedOut,    // ModuleTimer ran out first
+  RoundInactive,    // no sensor activity, the game was abandoned
+  RoundGameOver     // the game timer ran out during the round
+}RoundOutcome_t;
+
+#ifdef GAME_TELEMETRY
+void Telemetry_GameStart(void);
+void Telemetry_RoundStart(uint8_t Module);
+void Telemetry_RoundEnd(RoundOutcome_t Outcome);
+void Telemetry_GameEnd(uint32_t Points);
+#else
+#define Telemetry_GameStart()           ((void)0)
+#define Telemetry_RoundStart(Module)    ((void)0)
+#define Telemetry_RoundEnd(Outcome)     ((void)0)
+#define Telemetry_GameEnd(Points)       ((void)0)
+#endif
+
+#endif /* GAMETELEMETRY_H */
@@ -26,6 +26,7 @@ bool InitLEDService(uint8_t Priority);
 bool PostLEDService(ES_Event_t ThisEvent);
 ES_Event_t RunLEDService(ES_Event_t ThisEvent);
 TemplateState_t QueryDisplayCharFSM(void);
+bool CheckDisplayDone(void);
 
 #endif /* ServTemplate_H */
 
@@ -0,0 +1,76 @@
+/****************************************************************************
+ Module
+     MAX7219Emu.h
+
+ Description
+     Host only emulation of the MAX7219 chain, for testing the display
+     driver without the matrix. It takes the 16 bit words the driver writes
+     to SPI1 (DisplayTx_SimWrite in host builds) and the rising edges of SS,
+     decodes the register writes for each controller in the chain, and
+     rebuilds the image the modules would show.
+
+ Notes
+     The words shift through the chain as they do through the real one: a
+     latch leaves the first word sent in the controller at the far end,
+     which is module 0, the right end of the display. Digit register d of a
+     module is display row 8 - d and segment bit b is column b of the module
+     from the left, the way the ME218 modules are wired.
+     Shutdown, display test, scan limit and Code B decode are applied to the
+     image; intensity only shows in the PPM output.
+     Every word is counted. MaxEmu_EndFrame marks the end of a display
+     update, for the words per frame and the frame rate the SPI could carry.
+     Not built for the PIC32.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 23:55 mp      first pass
+*****************************************************************************/
+#ifndef MAX7219EMU_H
+#define MAX7219EMU_H
+
+#ifdef HOST_TEST
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "DisplayTx.h"
+
+#define MAXEMU_MODULES  DISPLAY_CHAIN_LEN
+#define MAXEMU_ROWS     8
+#define MAXEMU_COLS     (MAXEMU_MODULES * 8)
+
+// the registers of one controller
+typedef struct
+{
+  uint8_t Digits[8];    // digit registers 1 to 8
+  uint8_t DecodeMode;   // one bit per digit, 1 for Code B
+  uint8_t Intensity;    // 0 to 15
+  uint8_t ScanLimit;    // last digit shown, 0 to 7
+  bool    Shutdown;
+  bool    DisplayTest;
+} MaxEmu_Device_t;
+
+typedef struct
+{
+  uint32_t Words;
+  uint32_t Latches;
+  uint32_t Misframed;     // latches that were not one word per controller
+  uint32_t Frames;
+  uint32_t MaxFrameWords;
+  uint32_t LastFrameWords;
+} MaxEmu_Stats_t;
+
+void MaxEmu_Init(void);
+void MaxEmu_ShiftWord(uint16_t Word);
+void MaxEmu_Latch(void);
+void MaxEmu_EndFrame(void);
+const MaxEmu_Device_t *MaxEmu_GetDevice(uint8_t Module);
+bool MaxEmu_GetPixel(uint8_t Row, uint16_t Col);
+bool MaxEmu_MatchesImage(const char * const *pRows);
+void MaxEmu_GetStats(MaxEmu_Stats_t *pStats);
+void MaxEmu_PrintImage(FILE *pOut);
+void MaxEmu_PrintStats(FILE *pOut, uint32_t BitTime_ns);
+bool MaxEmu_WritePPM(const char *pFileName, uint8_t Scale);
+#endif // HOST_TEST
+
+#endif /* MAX7219EMU_H */
@@ -0,0 +1,43 @@
+/****************************************************************************
+ Module
+     Marquee.h
+
+ Description
+     Smooth scrolling of messages wider than the display. The message is
+     drawn once into an off-screen canvas and each step copies the next
+     window of it, one column further on, onto the compositor's text layer.
+
+ Notes
+     The canvas holds the message with a display width of blank columns on
+     either side, so the message comes in from the right, goes out to the
+     left and starts again. Steps never draw glyphs, they only shift words;
+     Comp_Compose and DM_CommitFrame then pick out the rows that changed. The caller sets
+     the pace, LEDService steps it from MarqueeTimer every
+     Marquee_GetColumnMs, which can be changed while it runs.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:35 mp      the time for each column is set at run time
+ 10/18/26 23:50 mp      steps draw on the compositor's text layer
+ 10/18/26 23:40 mp      first pass
+*****************************************************************************/
+#ifndef MARQUEE_H
+#define MARQUEE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// longest message the canvas takes, longer ones are cut short
+#define MARQUEE_MAX_CHARS   64
+// time for each column, in ms, until Marquee_SetColumnMs
+#define MARQUEE_COLUMN_MS   40
+
+bool Marquee_Start(const unsigned char *pMessage);
+void Marquee_Step(void);
+void Marquee_Stop(void);
+bool Marquee_IsRunning(void);
+void Marquee_SetColumnMs(uint16_t Ms);
+uint16_t Marquee_GetColumnMs(void);
+
+#endif /* MARQUEE_H */
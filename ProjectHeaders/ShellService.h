@@ -0,0 +1,22 @@
+/****************************************************************************
+
+  Header file for the introspection shell service
+  based on the Gen 2 Events and Services Framework
+
+ ****************************************************************************/
+
+#ifndef ShellService_H
+#define ShellService_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ES_Events.h"
+#include "ES_Port.h"                // needed for definition of REENTRANT
+// Public Function Prototypes
+
+bool InitShellService(uint8_t Priority);
+bool PostShellService(ES_Event_t ThisEvent);
+ES_Event_t RunShellService(ES_Event_t ThisEvent);
+
+#endif /* ShellService_H */
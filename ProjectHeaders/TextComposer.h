@@ -0,0 +1,39 @@
+/****************************************************************************
+ Module
+     TextComposer.h
+
+ Description
+     Builds fixed-field display lines without printf: left aligned text
+     fields and right aligned integer fields, written straight into the
+     caller's line buffer.
+
+ Notes
+     The line is kept NUL terminated after every call. Anything that does
+     not fit is dropped, the line never runs past its buffer. A number wider
+     than its field is written in full, as printf would.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 21:20 mp      first pass
+*****************************************************************************/
+#ifndef TEXTCOMPOSER_H
+#define TEXTCOMPOSER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct
+{
+  char    *pLine;
+  uint8_t Size;       // of the buffer, including the NUL
+  uint8_t Length;     // characters written so far
+}TextComposer_t;
+
+void TC_Begin(TextComposer_t *pTC, char *pLine, uint8_t Size);
+void TC_PutText(TextComposer_t *pTC, const char *pText, uint8_t Width);
+void TC_PutUnsigned(TextComposer_t *pTC, uint32_t Value, uint8_t Width);
+void TC_PutInt(TextComposer_t *pTC, int32_t Value, uint8_t Width);
+uint8_t TC_End(TextComposer_t *pTC);
+
+#endif /* TEXTCOMPOSER_H */
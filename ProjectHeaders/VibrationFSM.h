@@ -24,6 +24,7 @@ typedef enum
 bool InitVibrationFSM(uint8_t Priority);
 bool PostVibrationFSM(ES_Event_t ThisEvent);
 ES_Event_t RunVibrationFSM(ES_Event_t ThisEvent);
+VibrationState_t QueryVibrationFSM(void);
 bool CheckAnalogValue();
 
 
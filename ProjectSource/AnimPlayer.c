@@ -0,0 +1,402 @@
+/****************************************************************************
+ Module
+   AnimPlayer.c
+
+ Revision
+   1.0.0
+
+ Description
+   Decodes flash resident frame sequences onto a compositor layer, see
+   AnimPlayer.h.
+
+ Notes
+   The sequence is drawn at the left end of the layer and the layer moved
+   to the sequence's column, so the compositor does the placing. Modules of
+   a sequence wider than the display are decoded and dropped.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      the harness uses Seconds from host_test.h
+ 10/18/26 23:58 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <string.h>
+#include "DM_Display.h"
+#include "Compositor.h"
+#include "AnimPlayer.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define NUM_ROWS    8
+#define RUN_FLAG    0x80
+#define COUNT_MASK  0x7F
+
+/*---------------------------- Module Functions ---------------------------*/
+static const uint8_t *DecodeRow(const uint8_t *pData, uint8_t Width,
+                                uint32_t *pRow);
+
+/*---------------------------- Module Variables ---------------------------*/
+static const Anim_t *pPlaying;
+// the next frame's record and its number
+static const uint8_t *pNext;
+static uint16_t NextFrame;
+static CompLayer_t AnimLayer;
+static bool Looping;
+static bool Running;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   Anim_Start
+
+ Parameters
+   const Anim_t *pAnim : the sequence to play
+   CompLayer_t Layer : the layer to play it on
+   bool Loop : true to go back to the first frame after the last
+
+ Returns
+   nothing
+
+ Description
+   Clears the layer and moves it to the sequence's column. The first
+   Anim_Step draws the first frame.
+ Author
+   M. Peraza, 10/18/26 23:58
+****************************************************************************/
+void Anim_Start(const Anim_t *pAnim, CompLayer_t Layer, bool Loop)
+{
+  if (Running && (Layer != AnimLayer))
+  {
+    Comp_ClearLayer(AnimLayer);
+  }
+  pPlaying = pAnim;
+  pNext = pAnim->pData;
+  NextFrame = 0;
+  AnimLayer = Layer;
+  Looping = Loop;
+  Running = true;
+  Comp_ClearLayer(Layer);
+  Comp_SetOffset(Layer, pAnim->Column, 0);
+}
+
+/****************************************************************************
+ Function
+   Anim_Step
+
+ Parameters
+   None
+
+ Returns
+   bool : true if a frame was drawn; false once a sequence that does not
+   loop has shown its last frame, or when nothing is playing
+
+ Description
+   Decodes the next frame onto the layer, writing only the rows that
+   change. The caller composes and commits the frame.
+ Author
+   M. Peraza, 10/18/26 23:58
+****************************************************************************/
+bool Anim_Step(void)
+{
+  uint32_t Row[DM_ROW_WORDS];
+  uint8_t Changed;
+  uint8_t WhichRow;
+
+  if (!Running)
+  {
+    return false;
+  }
+  if (NextFrame == pPlaying->NumFrames)
+  {
+    if (!Looping)
+    {
+      Running = false;    // the last frame stays up
+      return false;
+    }
+    pNext = pPlaying->pData;
+    NextFrame = 0;
+  }
+  Changed = *pNext++;
+  for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+  {
+    if (Changed & (1u << WhichRow))
+    {
+      pNext = DecodeRow(pNext, pPlaying->Width, Row);
+      Comp_PutLayerRow(AnimLayer, Row, WhichRow);
+    }
+  }
+  NextFrame++;
+  return true;
+}
+
+/****************************************************************************
+ Function
+   Anim_Stop
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   Stops playing and clears the layer.
+ Author
+   M. Peraza, 10/18/26 23:58
+****************************************************************************/
+void Anim_Stop(void)
+{
+  if (Running)
+  {
+    Running = false;
+    Comp_ClearLayer(AnimLayer);
+  }
+}
+
+/****************************************************************************
+ Function
+   Anim_IsRunning
+
+ Parameters
+   None
+
+ Returns
+   bool : true from Anim_Start until Anim_Stop or the end of a sequence
+   that does not loop
+
+ Author
+   M. Peraza, 10/18/26 23:58
+****************************************************************************/
+bool Anim_IsRunning(void)
+{
+  return Running;
+}
+
+/****************************************************************************
+ Function
+   Anim_GetPeriod
+
+ Parameters
+   None
+
+ Returns
+   uint16_t : ms between the frames of the sequence playing, 0 if none
+
+ Author
+   M. Peraza, 10/18/26 23:58
+****************************************************************************/
+uint16_t Anim_GetPeriod(void)
+{
+  return Running ? pPlaying->PeriodMs : 0;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+// decodes a run length encoded row of Width modules into a display row,
+// returns where the next row starts
+static const uint8_t *DecodeRow(const uint8_t *pData, uint8_t Width,
+                                uint32_t *pRow)
+{
+  uint8_t Module = 0;   // from the left
+  uint8_t Count;
+  uint8_t Byte = 0;
+  uint8_t Shift;
+  bool IsRun;
+
+  memset(pRow, 0, DM_ROW_WORDS * sizeof(uint32_t));
+  while (Module < Width)
+  {
+    IsRun = (*pData & RUN_FLAG) != 0;
+    Count = (*pData++ & COUNT_MASK) + 1;
+    if (IsRun)
+    {
+      Byte = *pData++;
+    }
+    for ( ; Count > 0; Count--, Module++)
+    {
+      if (!IsRun)
+      {
+        Byte = *pData++;
+      }
+      // the display's module 0 is at the right end
+      if ((Byte != 0) && (Module < DM_NUM_MODULES))
+      {
+        Shift = DM_NUM_MODULES - 1 - Module;
+        pRow[Shift / 4] |= (uint32_t)Byte << ((Shift % 4) * 8);
+      }
+    }
+  }
+  return pData;
+}
+
+/***************************************************************************
+ module test harness, plays the idle sequence from Animations.c and checks
+ every frame on the display buffer against the frames it was encoded from,
+ then reports the flash used and rows written, and times a step. Run it
+ from the top of the repository, it reads Tools/anims/idle.txt
+ gcc -c -IFrameworkHeaders FrameworkSource/spsc_ring.c
+ gcc -O2 -DHOST_TEST -c -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/DM_DisplayStarter.c ProjectSource/DisplayTx.c \
+     ProjectSource/FontStuff.c ProjectSource/FontGlyphs.c \
+     ProjectSource/Compositor.c ProjectSource/Animations.c
+ gcc -O2 -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/AnimPlayer.c Compositor.o Animations.o \
+     DM_DisplayStarter.o DisplayTx.o FontStuff.o FontGlyphs.o spsc_ring.o \
+     -o anim_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include "host_test.h"
+
+#define FRAMES_FILE  "Tools/anims/idle.txt"
+#define MAX_FRAMES   256
+#define MAX_COLS     256
+#define BENCH_STEPS  1000000u
+
+static char Frames[MAX_FRAMES][NUM_ROWS][MAX_COLS + 2];
+static uint16_t NumFrames;
+
+void DisplayTx_SimWrite(uint16_t Word)
+{
+}
+
+// reads the text frames the sequence was encoded from
+static bool LoadFrames(void)
+{
+  char Line[MAX_COLS + 2];
+  FILE *pFile = fopen(FRAMES_FILE, "r");
+  uint8_t Row = 0;
+
+  if (pFile == NULL)
+  {
+    return false;
+  }
+  while (fgets(Line, sizeof(Line), pFile) != NULL)
+  {
+    if ((Line[0] == ';') || (Line[0] == '\n') || (Line[0] == '\r'))
+    {
+      continue;
+    }
+    strcpy(Frames[NumFrames][Row], Line);
+    if (++Row == NUM_ROWS)
+    {
+      Row = 0;
+      if (++NumFrames == MAX_FRAMES)
+      {
+        break;
+      }
+    }
+  }
+  fclose(pFile);
+  return (NumFrames > 0) && (Row == 0);
+}
+
+// the display buffer against a frame drawn at Column, pixel for pixel
+static bool MatchesFrame(uint16_t Frame, int16_t Column)
+{
+  uint32_t Row[DM_ROW_WORDS];
+  const char *pLine;
+  uint8_t WhichRow;
+  uint16_t Bit;
+  bool Expected;
+  int x;
+  int Col;
+
+  for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+  {
+    DM_QueryRowData(WhichRow, Row);
+    pLine = Frames[Frame][WhichRow];
+    for (x = 0; x < DM_NUM_MODULES * 8; x++)
+    {
+      Col = x - Column;
+      Expected = (Col >= 0) && (Col < (int)strlen(pLine)) &&
+                 (pLine[Col] == '#');
+      Bit = DM_NUM_MODULES * 8 - 1 - x;
+      if (Expected != ((Row[Bit / 32] >> (Bit % 32)) & 1))
+      {
+        fprintf(stdout, "failed: frame %u row %u column %d\n",
+                (unsigned)Frame, WhichRow, x);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main(void)
+{
+  const Anim_t *pAnim = Animations[AnimIdle];
+  uint32_t Blank[DM_ROW_WORDS] = { 0 };
+  uint32_t Row[DM_ROW_WORDS];
+  uint32_t RowsWritten = 0;
+  uint32_t Bytes = 0;
+  uint32_t Step;
+  uint8_t Rebuilt;
+  double Start;
+  bool Passed = true;
+
+  if (!LoadFrames())
+  {
+    puts("can't read " FRAMES_FILE);
+    return 1;
+  }
+  Passed &= (NumFrames == pAnim->NumFrames);
+  DisplayTx_Init();
+  Comp_Init();
+  Comp_Compose();
+
+  // twice through, to check the loop back to the first frame
+  Anim_Start(pAnim, CompLayerEffect, true);
+  for (Step = 0; (Step < 2u * pAnim->NumFrames) && Passed; Step++)
+  {
+    Passed &= Anim_Step();
+    Rebuilt = Comp_Compose();
+    for ( ; Rebuilt != 0; Rebuilt >>= 1)
+    {
+      RowsWritten += Rebuilt & 1;
+    }
+    Passed &= MatchesFrame(Step % pAnim->NumFrames, pAnim->Column);
+    if (Step + 1 == pAnim->NumFrames)
+    {
+      Bytes = pNext - pAnim->pData;
+    }
+  }
+  fprintf(stdout, "%u frames in %u bytes of flash (%u raw), %u of %u rows "
+          "rebuilt\n", (unsigned)pAnim->NumFrames, (unsigned)Bytes,
+          (unsigned)(pAnim->NumFrames * NUM_ROWS * pAnim->Width),
+          (unsigned)RowsWritten, (unsigned)(2u * pAnim->NumFrames * NUM_ROWS));
+
+  // once through, then it stops on the last frame
+  Anim_Start(pAnim, CompLayerEffect, false);
+  for (Step = 0; Step < pAnim->NumFrames; Step++)
+  {
+    Passed &= Anim_Step();
+  }
+  Passed &= !Anim_Step() && !Anim_IsRunning();
+  Comp_Compose();
+  Passed &= MatchesFrame(pAnim->NumFrames - 1, pAnim->Column);
+
+  Anim_Start(pAnim, CompLayerEffect, true);
+  Start = Seconds();
+  for (Step = 0; Step < BENCH_STEPS; Step++)
+  {
+    Anim_Step();
+  }
+  fprintf(stdout, "%.0f ns per step\n",
+          (Seconds() - Start) / BENCH_STEPS * 1e9);
+
+  // stopping clears the layer
+  Anim_Stop();
+  Comp_Compose();
+  Passed &= !Anim_IsRunning() && (Anim_GetPeriod() == 0);
+  for (Step = 0; Step < NUM_ROWS; Step++)
+  {
+    DM_QueryRowData(Step, Row);
+    Passed &= (memcmp(Row, Blank, sizeof(Row)) == 0);
+  }
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,105 @@
+/****************************************************************************
+ Module
+   Animations.c
+
+ Description
+   Frame sequences for AnimPlayer, see AnimPlayer.h.
+
+ Notes
+   Generated by Tools/encode_anim.py, do not edit:
+     IdleAnim from Tools/anims/idle.txt
+****************************************************************************/
+#ifndef HOST_TEST
+#include <xc.h>
+#else
+#include <stdint.h>
+#endif
+#include "AnimPlayer.h"
+
+static const uint8_t IdleAnimData[954] = {
+  0xff, 0x83, 0x00, 0x83, 0x00, 0x83, 0x00, 0x83, 0x00, 0x00, 0x40, 0x82,
+  0x00, 0x00, 0xe0, 0x82, 0x00, 0x00, 0x40, 0x82, 0x00, 0x83, 0xff, 0x78,
+  0x00, 0x20, 0x82, 0x00, 0x00, 0x70, 0x82, 0x00, 0x00, 0x20, 0x82, 0x00,
+  0x83, 0x00, 0x3e, 0x00, 0x10, 0x82, 0x00, 0x00, 0x38, 0x82, 0x00, 0x00,
+  0x10, 0x82, 0x00, 0x83, 0x00, 0x83, 0x00, 0x0e, 0x00, 0x08, 0x82, 0x00,
+  0x00, 0x1c, 0x82, 0x00, 0x00, 0x08, 0x82, 0x00, 0x0f, 0x00, 0x04, 0x82,
+  0x00, 0x00, 0x0e, 0x82, 0x00, 0x00, 0x04, 0x82, 0x00, 0x83, 0x00, 0x07,
+  0x00, 0x02, 0x82, 0x00, 0x00, 0x07, 0x82, 0x00, 0x00, 0x02, 0x82, 0x00,
+  0x07, 0x00, 0x01, 0x82, 0x00, 0x03, 0x03, 0x80, 0x00, 0x00, 0x00, 0x01,
+  0x82, 0x00, 0x0f, 0x83, 0x00, 0x03, 0x00, 0x80, 0x00, 0x00, 0x03, 0x01,
+  0xc0, 0x00, 0x00, 0x03, 0x00, 0x80, 0x00, 0x00, 0x0e, 0x03, 0x00, 0x40,
+  0x00, 0x00, 0x03, 0x00, 0xe0, 0x00, 0x00, 0x03, 0x00, 0x40, 0x00, 0x00,
+  0x3e, 0x83, 0x00, 0x83, 0x00, 0x03, 0x00, 0x20, 0x00, 0x00, 0x03, 0x00,
+  0x70, 0x00, 0x00, 0x03, 0x00, 0x20, 0x00, 0x00, 0x78, 0x83, 0x00, 0x03,
+  0x00, 0x10, 0x00, 0x00, 0x03, 0x00, 0x38, 0x00, 0x00, 0x03, 0x00, 0x10,
+  0x00, 0x00, 0x78, 0x03, 0x00, 0x08, 0x00, 0x00, 0x03, 0x00, 0x1c, 0x00,
+  0x00, 0x03, 0x00, 0x08, 0x00, 0x00, 0x83, 0x00, 0x3e, 0x03, 0x00, 0x04,
+  0x00, 0x00, 0x03, 0x00, 0x0e, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00, 0x00,
+  0x83, 0x00, 0x83, 0x00, 0x0e, 0x03, 0x00, 0x02, 0x00, 0x00, 0x03, 0x00,
+  0x07, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x0f, 0x03, 0x00, 0x01,
+  0x00, 0x00, 0x03, 0x00, 0x03, 0x80, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00,
+  0x83, 0x00, 0x07, 0x03, 0x00, 0x00, 0x80, 0x00, 0x03, 0x00, 0x01, 0xc0,
+  0x00, 0x03, 0x00, 0x00, 0x80, 0x00, 0x07, 0x03, 0x00, 0x00, 0x40, 0x00,
+  0x03, 0x00, 0x00, 0xe0, 0x00, 0x03, 0x00, 0x00, 0x40, 0x00, 0x0f, 0x83,
+  0x00, 0x03, 0x00, 0x00, 0x20, 0x00, 0x03, 0x00, 0x00, 0x70, 0x00, 0x03,
+  0x00, 0x00, 0x20, 0x00, 0x0e, 0x03, 0x00, 0x00, 0x10, 0x00, 0x03, 0x00,
+  0x00, 0x38, 0x00, 0x03, 0x00, 0x00, 0x10, 0x00, 0x3e, 0x83, 0x00, 0x83,
+  0x00, 0x03, 0x00, 0x00, 0x08, 0x00, 0x03, 0x00, 0x00, 0x1c, 0x00, 0x03,
+  0x00, 0x00, 0x08, 0x00, 0x78, 0x83, 0x00, 0x03, 0x00, 0x00, 0x04, 0x00,
+  0x03, 0x00, 0x00, 0x0e, 0x00, 0x03, 0x00, 0x00, 0x04, 0x00, 0x78, 0x03,
+  0x00, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x07, 0x00, 0x03, 0x00, 0x00,
+  0x02, 0x00, 0x83, 0x00, 0x3e, 0x03, 0x00, 0x00, 0x01, 0x00, 0x03, 0x00,
+  0x00, 0x03, 0x80, 0x03, 0x00, 0x00, 0x01, 0x00, 0x83, 0x00, 0x83, 0x00,
+  0x0e, 0x82, 0x00, 0x00, 0x80, 0x03, 0x00, 0x00, 0x01, 0xc0, 0x82, 0x00,
+  0x00, 0x80, 0x0f, 0x82, 0x00, 0x00, 0x40, 0x82, 0x00, 0x00, 0xe0, 0x82,
+  0x00, 0x00, 0x40, 0x83, 0x00, 0x07, 0x82, 0x00, 0x00, 0x20, 0x82, 0x00,
+  0x00, 0x70, 0x82, 0x00, 0x00, 0x20, 0x07, 0x82, 0x00, 0x00, 0x10, 0x82,
+  0x00, 0x00, 0x38, 0x82, 0x00, 0x00, 0x10, 0x0f, 0x83, 0x00, 0x82, 0x00,
+  0x00, 0x08, 0x82, 0x00, 0x00, 0x1c, 0x82, 0x00, 0x00, 0x08, 0x0e, 0x82,
+  0x00, 0x00, 0x04, 0x82, 0x00, 0x00, 0x0e, 0x82, 0x00, 0x00, 0x04, 0x3e,
+  0x83, 0x00, 0x83, 0x00, 0x82, 0x00, 0x00, 0x02, 0x82, 0x00, 0x00, 0x07,
+  0x82, 0x00, 0x00, 0x02, 0x78, 0x83, 0x00, 0x82, 0x00, 0x00, 0x04, 0x82,
+  0x00, 0x00, 0x0e, 0x82, 0x00, 0x00, 0x04, 0x78, 0x82, 0x00, 0x00, 0x08,
+  0x82, 0x00, 0x00, 0x1c, 0x82, 0x00, 0x00, 0x08, 0x83, 0x00, 0x3e, 0x82,
+  0x00, 0x00, 0x10, 0x82, 0x00, 0x00, 0x38, 0x82, 0x00, 0x00, 0x10, 0x83,
+  0x00, 0x83, 0x00, 0x0e, 0x82, 0x00, 0x00, 0x20, 0x82, 0x00, 0x00, 0x70,
+  0x82, 0x00, 0x00, 0x20, 0x0f, 0x82, 0x00, 0x00, 0x40, 0x82, 0x00, 0x00,
+  0xe0, 0x82, 0x00, 0x00, 0x40, 0x83, 0x00, 0x07, 0x82, 0x00, 0x00, 0x80,
+  0x03, 0x00, 0x00, 0x01, 0xc0, 0x82, 0x00, 0x00, 0x80, 0x07, 0x03, 0x00,
+  0x00, 0x01, 0x00, 0x03, 0x00, 0x00, 0x03, 0x80, 0x03, 0x00, 0x00, 0x01,
+  0x00, 0x0f, 0x83, 0x00, 0x03, 0x00, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00,
+  0x07, 0x00, 0x03, 0x00, 0x00, 0x02, 0x00, 0x0e, 0x03, 0x00, 0x00, 0x04,
+  0x00, 0x03, 0x00, 0x00, 0x0e, 0x00, 0x03, 0x00, 0x00, 0x04, 0x00, 0x3e,
+  0x83, 0x00, 0x83, 0x00, 0x03, 0x00, 0x00, 0x08, 0x00, 0x03, 0x00, 0x00,
+  0x1c, 0x00, 0x03, 0x00, 0x00, 0x08, 0x00, 0x78, 0x83, 0x00, 0x03, 0x00,
+  0x00, 0x10, 0x00, 0x03, 0x00, 0x00, 0x38, 0x00, 0x03, 0x00, 0x00, 0x10,
+  0x00, 0x78, 0x03, 0x00, 0x00, 0x20, 0x00, 0x03, 0x00, 0x00, 0x70, 0x00,
+  0x03, 0x00, 0x00, 0x20, 0x00, 0x83, 0x00, 0x3e, 0x03, 0x00, 0x00, 0x40,
+  0x00, 0x03, 0x00, 0x00, 0xe0, 0x00, 0x03, 0x00, 0x00, 0x40, 0x00, 0x83,
+  0x00, 0x83, 0x00, 0x0e, 0x03, 0x00, 0x00, 0x80, 0x00, 0x03, 0x00, 0x01,
+  0xc0, 0x00, 0x03, 0x00, 0x00, 0x80, 0x00, 0x0f, 0x03, 0x00, 0x01, 0x00,
+  0x00, 0x03, 0x00, 0x03, 0x80, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x83,
+  0x00, 0x07, 0x03, 0x00, 0x02, 0x00, 0x00, 0x03, 0x00, 0x07, 0x00, 0x00,
+  0x03, 0x00, 0x02, 0x00, 0x00, 0x07, 0x03, 0x00, 0x04, 0x00, 0x00, 0x03,
+  0x00, 0x0e, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00, 0x00, 0x0f, 0x83, 0x00,
+  0x03, 0x00, 0x08, 0x00, 0x00, 0x03, 0x00, 0x1c, 0x00, 0x00, 0x03, 0x00,
+  0x08, 0x00, 0x00, 0x0e, 0x03, 0x00, 0x10, 0x00, 0x00, 0x03, 0x00, 0x38,
+  0x00, 0x00, 0x03, 0x00, 0x10, 0x00, 0x00, 0x3e, 0x83, 0x00, 0x83, 0x00,
+  0x03, 0x00, 0x20, 0x00, 0x00, 0x03, 0x00, 0x70, 0x00, 0x00, 0x03, 0x00,
+  0x20, 0x00, 0x00, 0x78, 0x83, 0x00, 0x03, 0x00, 0x40, 0x00, 0x00, 0x03,
+  0x00, 0xe0, 0x00, 0x00, 0x03, 0x00, 0x40, 0x00, 0x00, 0x78, 0x03, 0x00,
+  0x80, 0x00, 0x00, 0x03, 0x01, 0xc0, 0x00, 0x00, 0x03, 0x00, 0x80, 0x00,
+  0x00, 0x83, 0x00, 0x3e, 0x00, 0x01, 0x82, 0x00, 0x03, 0x03, 0x80, 0x00,
+  0x00, 0x00, 0x01, 0x82, 0x00, 0x83, 0x00, 0x83, 0x00, 0x0e, 0x00, 0x02,
+  0x82, 0x00, 0x00, 0x07, 0x82, 0x00, 0x00, 0x02, 0x82, 0x00, 0x0f, 0x00,
+  0x04, 0x82, 0x00, 0x00, 0x0e, 0x82, 0x00, 0x00, 0x04, 0x82, 0x00, 0x83,
+  0x00, 0x07, 0x00, 0x08, 0x82, 0x00, 0x00, 0x1c, 0x82, 0x00, 0x00, 0x08,
+  0x82, 0x00, 0x07, 0x00, 0x10, 0x82, 0x00, 0x00, 0x38, 0x82, 0x00, 0x00,
+  0x10, 0x82, 0x00, 0x0f, 0x83, 0x00, 0x00, 0x20, 0x82, 0x00, 0x00, 0x70,
+  0x82, 0x00, 0x00, 0x20, 0x82, 0x00
+};
+const Anim_t IdleAnim = { IdleAnimData, 58, 60, 32, 4 };
+
+const Anim_t * const Animations[NUM_ANIMATIONS] = {
+  &IdleAnim
+};
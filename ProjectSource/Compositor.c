@@ -0,0 +1,606 @@
+/****************************************************************************
+ Module
+   Compositor.c
+
+ Revision
+   1.0.0
+
+ Description
+   Combines the 1 bit layers into the display buffer, see Compositor.h.
+
+ Notes
+   Layer rows are laid out like display rows, DM_ROW_WORDS words with word
+   0 least significant and display column x (0 at the left) in bit
+   DISPLAY_COLS - 1 - x. Moving a layer right is then shifting its rows
+   towards bit 0. Nothing is kept above the display, so shifts bring in
+   zeros from both ends.
+   StaleRows marks the source rows of a layer that changed since its
+   placed copy was made; all of them after a move, which redoes the rows
+   with no source row too. Rows of the output that a new placed copy
+   changed, or all of them after a layer was hidden, shown or given a new
+   operation, are rebuilt from every visible layer on Comp_Compose.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      the harness uses Seconds from host_test.h
+ 10/18/26 23:50 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <string.h>
+#include "DM_Display.h"
+#include "Compositor.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define NUM_ROWS      8
+#define ALL_ROWS      ((1u << NUM_ROWS) - 1)
+#define DISPLAY_COLS  (DM_NUM_MODULES * 8)
+
+/*------------------------------ Module Types -----------------------------*/
+typedef struct
+{
+  // what has been drawn on the layer
+  uint32_t Pixels[NUM_ROWS][DM_ROW_WORDS];
+  // the pixels moved to the layer's offset, what goes into the output
+  uint32_t Placed[NUM_ROWS][DM_ROW_WORDS];
+  int16_t XOffset;    // columns to the right
+  int8_t YOffset;     // rows down
+  CompOp_t Op;
+  bool Visible;
+  uint8_t StaleRows;  // Pixels rows not yet in Placed
+} Layer_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static uint8_t PlaceLayer(Layer_t *pLayer);
+static void ShiftRow(const uint32_t *pSrc, int16_t Cols, uint32_t *pDst);
+
+/*---------------------------- Module Variables ---------------------------*/
+static Layer_t Layers[COMP_NUM_LAYERS];
+// rows of the output to rebuild on the next Comp_Compose
+static uint8_t DirtyRows;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   Comp_Init
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   Clears every layer, back to no offset, visible and ORed on. The next
+   Comp_Compose writes every row.
+ Author
+   M. Peraza, 10/18/26 23:50
+****************************************************************************/
+void Comp_Init(void)
+{
+  uint8_t WhichLayer;
+
+  memset(Layers, 0, sizeof(Layers));
+  for (WhichLayer = 0; WhichLayer < COMP_NUM_LAYERS; WhichLayer++)
+  {
+    Layers[WhichLayer].Op = CompOpOr;
+    Layers[WhichLayer].Visible = true;
+  }
+  DirtyRows = ALL_ROWS;
+}
+
+/****************************************************************************
+ Function
+   Comp_ClearLayer
+
+ Parameters
+   CompLayer_t Layer : the layer to clear
+
+ Returns
+   nothing
+
+ Author
+   M. Peraza, 10/18/26 23:50
+****************************************************************************/
+void Comp_ClearLayer(CompLayer_t Layer)
+{
+  memset(Layers[Layer].Pixels, 0, sizeof(Layers[Layer].Pixels));
+  Layers[Layer].StaleRows = ALL_ROWS;
+}
+
+/****************************************************************************
+ Function
+   Comp_DrawString
+
+ Parameters
+   CompLayer_t Layer : the layer to draw on
+   const unsigned char *pString : the string
+   DM_Align_t Align : where to put it when it is shorter than the display
+
+ Returns
+   nothing
+
+ Description
+   Replaces what is on the layer with the string, drawn as DM_RenderString
+   does.
+ Author
+   M. Peraza, 10/18/26 23:50
+****************************************************************************/
+void Comp_DrawString(CompLayer_t Layer, const unsigned char *pString,
+                     DM_Align_t Align)
+{
+  Comp_ClearLayer(Layer);
+  DM_RenderStringInto(Layers[Layer].Pixels, pString, Align);
+}
+
+/****************************************************************************
+ Function
+   Comp_PutLayerRow
+
+ Parameters
+   CompLayer_t Layer : the layer to draw on
+   const uint32_t * pWords : DM_ROW_WORDS words, laid out as a display row
+   uint8_t WhichRow : the row (0->7)
+
+ Returns
+   bool : true for a legal row number; false otherwise
+
+ Description
+   Replaces a row of the layer. Only that row is redone on Comp_Compose,
+   and only if it is different.
+ Author
+   M. Peraza, 10/18/26 23:50
+****************************************************************************/
+bool Comp_PutLayerRow(CompLayer_t Layer, const uint32_t *pWords,
+                      uint8_t WhichRow)
+{
+  uint32_t *pRow;
+
+  if (WhichRow >= NUM_ROWS)
+  {
+    return false;
+  }
+  pRow = Layers[Layer].Pixels[WhichRow];
+  if (memcmp(pRow, pWords, sizeof(Layers[Layer].Pixels[0])) != 0)
+  {
+    memcpy(pRow, pWords, sizeof(Layers[Layer].Pixels[0]));
+#if DISPLAY_COLS % 32 != 0
+    // nothing above the display
+    pRow[DM_ROW_WORDS - 1] &= (1u << (DISPLAY_COLS % 32)) - 1;
+#endif
+    Layers[Layer].StaleRows |= 1u << WhichRow;
+  }
+  return true;
+}
+
+/****************************************************************************
+ Function
+   Comp_SetOffset
+
+ Parameters
+   CompLayer_t Layer : the layer to move
+   int16_t Cols : columns to the right, negative to the left
+   int8_t Rows : rows down, negative up
+
+ Returns
+   nothing
+
+ Description
+   Moves the layer relative to the display; whatever goes off an edge is
+   not shown.
+ Author
+   M. Peraza, 10/18/26 23:50
+****************************************************************************/
+void Comp_SetOffset(CompLayer_t Layer, int16_t Cols, int8_t Rows)
+{
+  if ((Layers[Layer].XOffset != Cols) || (Layers[Layer].YOffset != Rows))
+  {
+    Layers[Layer].XOffset = Cols;
+    Layers[Layer].YOffset = Rows;
+    Layers[Layer].StaleRows = ALL_ROWS;
+  }
+}
+
+/****************************************************************************
+ Function
+   Comp_SetVisible
+
+ Parameters
+   CompLayer_t Layer : the layer to show or hide
+   bool Visible : true to show it
+
+ Returns
+   nothing
+
+ Description
+   A hidden layer keeps its pixels and offset but is left out of the output.
+ Author
+   M. Peraza, 10/18/26 23:50
+****************************************************************************/
+void Comp_SetVisible(CompLayer_t Layer, bool Visible)
+{
+  if (Layers[Layer].Visible != Visible)
+  {
+    Layers[Layer].Visible = Visible;
+    DirtyRows = ALL_ROWS;
+  }
+}
+
+/****************************************************************************
+ Function
+   Comp_SetOp
+
+ Parameters
+   CompLayer_t Layer : the layer
+   CompOp_t Op : how it goes onto the layers below it
+
+ Returns
+   nothing
+
+ Author
+   M. Peraza, 10/18/26 23:50
+****************************************************************************/
+void Comp_SetOp(CompLayer_t Layer, CompOp_t Op)
+{
+  if (Layers[Layer].Op != Op)
+  {
+    Layers[Layer].Op = Op;
+    DirtyRows = ALL_ROWS;
+  }
+}
+
+/****************************************************************************
+ Function
+   Comp_Compose
+
+ Parameters
+   None
+
+ Returns
+   uint8_t : one bit for each row of the display buffer that was rebuilt
+
+ Description
+   Brings the placed copy of each changed layer up to date, then rebuilds
+   the rows of the display buffer that those changed from the visible
+   layers, bottom first. Rows no layer changed are left alone, so with
+   nothing changed it returns 0 without touching the buffer. Call
+   DM_CommitFrame after it.
+ Author
+   M. Peraza, 10/18/26 23:50
+****************************************************************************/
+uint8_t Comp_Compose(void)
+{
+  uint32_t Row[DM_ROW_WORDS];
+  const uint32_t *pPlaced;
+  uint8_t Rebuilt;
+  uint8_t WhichLayer;
+  uint8_t WhichRow;
+  uint8_t WhichWord;
+
+  for (WhichLayer = 0; WhichLayer < COMP_NUM_LAYERS; WhichLayer++)
+  {
+    if (Layers[WhichLayer].StaleRows != 0)
+    {
+      DirtyRows |= PlaceLayer(&Layers[WhichLayer]);
+    }
+  }
+
+  for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+  {
+    if ((DirtyRows & (1u << WhichRow)) == 0)
+    {
+      continue;
+    }
+    memset(Row, 0, sizeof(Row));
+    for (WhichLayer = 0; WhichLayer < COMP_NUM_LAYERS; WhichLayer++)
+    {
+      if (!Layers[WhichLayer].Visible)
+      {
+        continue;
+      }
+      pPlaced = Layers[WhichLayer].Placed[WhichRow];
+      switch (Layers[WhichLayer].Op)
+      {
+        case CompOpAnd:
+          for (WhichWord = 0; WhichWord < DM_ROW_WORDS; WhichWord++)
+          {
+            Row[WhichWord] &= pPlaced[WhichWord];
+          }
+          break;
+        case CompOpXor:
+          for (WhichWord = 0; WhichWord < DM_ROW_WORDS; WhichWord++)
+          {
+            Row[WhichWord] ^= pPlaced[WhichWord];
+          }
+          break;
+        default:
+          for (WhichWord = 0; WhichWord < DM_ROW_WORDS; WhichWord++)
+          {
+            Row[WhichWord] |= pPlaced[WhichWord];
+          }
+          break;
+      }
+    }
+    DM_PutDataIntoBufferRow(Row, WhichRow);
+  }
+  Rebuilt = DirtyRows;
+  DirtyRows = 0;
+  return Rebuilt;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+// redoes the placed rows of a layer whose source rows are stale, returns
+// the placed rows that came out different
+static uint8_t PlaceLayer(Layer_t *pLayer)
+{
+  uint32_t Row[DM_ROW_WORDS];
+  uint8_t Changed = 0;
+  uint8_t WhichRow;
+  int8_t Source;
+
+  for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+  {
+    Source = (int8_t)WhichRow - pLayer->YOffset;
+    if ((Source < 0) || (Source >= NUM_ROWS))
+    {
+      // off the layer, blank, and only changes when the layer moves
+      if (pLayer->StaleRows != ALL_ROWS)
+      {
+        continue;
+      }
+      memset(Row, 0, sizeof(Row));
+    }
+    else if (pLayer->StaleRows & (1u << Source))
+    {
+      ShiftRow(pLayer->Pixels[Source], pLayer->XOffset, Row);
+    }
+    else
+    {
+      continue;
+    }
+    if (memcmp(pLayer->Placed[WhichRow], Row, sizeof(Row)) != 0)
+    {
+      memcpy(pLayer->Placed[WhichRow], Row, sizeof(Row));
+      Changed |= 1u << WhichRow;
+    }
+  }
+  pLayer->StaleRows = 0;
+  return Changed;
+}
+
+// a row moved Cols columns to the right (towards bit 0), or to the left if
+// Cols is negative, zeros coming in at either end
+static void ShiftRow(const uint32_t *pSrc, int16_t Cols, uint32_t *pDst)
+{
+  uint16_t Shift = (Cols < 0) ? -Cols : Cols;
+  uint16_t WordShift = Shift / 32;
+  uint8_t BitShift = Shift % 32;
+  int16_t WhichWord;
+  int16_t From;
+  uint32_t Word;
+
+  for (WhichWord = 0; WhichWord < DM_ROW_WORDS; WhichWord++)
+  {
+    Word = 0;
+    if (Cols >= 0)
+    {
+      From = WhichWord + WordShift;
+      if (From < DM_ROW_WORDS)
+      {
+        Word = pSrc[From] >> BitShift;
+        if ((BitShift != 0) && (From + 1 < DM_ROW_WORDS))
+        {
+          Word |= pSrc[From + 1] << (32 - BitShift);
+        }
+      }
+    }
+    else
+    {
+      From = WhichWord - WordShift;
+      if (From >= 0)
+      {
+        Word = pSrc[From] << BitShift;
+        if ((BitShift != 0) && (From > 0))
+        {
+          Word |= pSrc[From - 1] >> (32 - BitShift);
+        }
+      }
+    }
+    pDst[WhichWord] = Word;
+  }
+#if DISPLAY_COLS % 32 != 0
+  pDst[DM_ROW_WORDS - 1] &= (1u << (DISPLAY_COLS % 32)) - 1;
+#endif
+}
+
+/***************************************************************************
+ module test harness, makes random changes to the layers and checks the
+ display buffer against the layers composed pixel by pixel after each one,
+ and times recomposing after a small change
+ gcc -c -IFrameworkHeaders FrameworkSource/spsc_ring.c
+ gcc -O2 -DHOST_TEST -c -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/DM_DisplayStarter.c ProjectSource/DisplayTx.c \
+     ProjectSource/FontStuff.c ProjectSource/FontGlyphs.c
+ gcc -O2 -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/Compositor.c DM_DisplayStarter.o DisplayTx.o \
+     FontStuff.o FontGlyphs.o spsc_ring.o -o compositor_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include "host_test.h"
+
+#define NUM_CHANGES 20000u
+#define BENCH_LOOPS 1000000u
+
+static uint32_t Seed = 218;
+
+void DisplayTx_SimWrite(uint16_t Word)
+{
+}
+
+static uint32_t Random(void)
+{
+  Seed = Seed * 1664525u + 1013904223u;
+  return Seed >> 8;
+}
+
+static bool GetPixel(const uint32_t *pRow, int x)
+{
+  return (pRow[(DISPLAY_COLS - 1 - x) / 32] >> ((DISPLAY_COLS - 1 - x) % 32))
+         & 1;
+}
+
+// the display pixel at column x, row y composed from the layers' pixels,
+// without the placed copies
+static bool Expected(int x, int y)
+{
+  const Layer_t *pLayer;
+  bool Pixel = false;
+  bool LayerPixel;
+  int Col;
+  int Row;
+  uint8_t WhichLayer;
+
+  for (WhichLayer = 0; WhichLayer < COMP_NUM_LAYERS; WhichLayer++)
+  {
+    pLayer = &Layers[WhichLayer];
+    if (!pLayer->Visible)
+    {
+      continue;
+    }
+    Col = x - pLayer->XOffset;
+    Row = y - pLayer->YOffset;
+    LayerPixel = (Col >= 0) && (Col < DISPLAY_COLS) && (Row >= 0) &&
+                 (Row < NUM_ROWS) && GetPixel(pLayer->Pixels[Row], Col);
+    switch (pLayer->Op)
+    {
+      case CompOpAnd: Pixel = Pixel && LayerPixel; break;
+      case CompOpXor: Pixel = Pixel != LayerPixel; break;
+      default:        Pixel = Pixel || LayerPixel; break;
+    }
+  }
+  return Pixel;
+}
+
+static bool CheckBuffer(uint32_t Change)
+{
+  uint32_t Row[DM_ROW_WORDS];
+  uint8_t y;
+  int x;
+
+  for (y = 0; y < NUM_ROWS; y++)
+  {
+    DM_QueryRowData(y, Row);
+    for (x = 0; x < DISPLAY_COLS; x++)
+    {
+      if (GetPixel(Row, x) != Expected(x, y))
+      {
+        fprintf(stdout, "failed: change %u row %u column %d\n",
+                (unsigned)Change, y, x);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// one random change to a random layer
+static void RandomChange(void)
+{
+  static const char *Strings[] = { "Squeeze!", "12pts", "GAME OVER", "8" };
+  uint32_t Row[DM_ROW_WORDS];
+  CompLayer_t Layer = Random() % COMP_NUM_LAYERS;
+  uint8_t WhichWord;
+
+  switch (Random() % 6)
+  {
+    case 0:
+      Comp_DrawString(Layer, (const unsigned char *)Strings[Random() % 4],
+                      Random() % 3);
+      break;
+    case 1:
+      for (WhichWord = 0; WhichWord < DM_ROW_WORDS; WhichWord++)
+      {
+        Row[WhichWord] = Random() ^ (Random() << 16);
+      }
+      Comp_PutLayerRow(Layer, Row, Random() % NUM_ROWS);
+      break;
+    case 2:
+      Comp_SetOffset(Layer,
+                     (int16_t)(Random() % (2 * DISPLAY_COLS + 9)) -
+                     DISPLAY_COLS - 4, (int8_t)(Random() % 19) - 9);
+      break;
+    case 3:
+      Comp_SetVisible(Layer, Random() % 3 != 0);
+      break;
+    case 4:
+      Comp_SetOp(Layer, Random() % 3);
+      break;
+    default:
+      Comp_ClearLayer(Layer);
+      break;
+  }
+}
+
+int main(void)
+{
+  uint32_t Row[DM_ROW_WORDS] = { 0 };
+  uint32_t Change;
+  uint32_t Loop;
+  double Start;
+  bool Passed = true;
+
+  DisplayTx_Init();
+  Comp_Init();
+  Passed &= (Comp_Compose() == ALL_ROWS);
+  Passed &= (Comp_Compose() == 0);    // nothing changed
+
+  for (Change = 0; (Change < NUM_CHANGES) && Passed; Change++)
+  {
+    RandomChange();
+    Comp_Compose();
+    Passed &= CheckBuffer(Change);
+  }
+
+  // a change to one row of a layer rebuilds only that row
+  Comp_Init();
+  Comp_DrawString(CompLayerText, (const unsigned char *)"Squeeze!",
+                  DM_AlignLeft);
+  Comp_DrawString(CompLayerScore, (const unsigned char *)"12",
+                  DM_AlignRight);
+  Comp_Compose();
+  Row[0] = 0x0F;
+  Comp_PutLayerRow(CompLayerEffect, Row, 6);
+  Passed &= (Comp_Compose() == (1u << 6));
+  Comp_PutLayerRow(CompLayerEffect, Row, 6);
+  Passed &= (Comp_Compose() == 0);    // the same row again
+  Comp_SetOffset(CompLayerEffect, 0, 1);
+  Passed &= (Comp_Compose() == ((1u << 6) | (1u << 7)));
+  Passed &= CheckBuffer(NUM_CHANGES);
+  fprintf(stdout, "%u random changes checked\n", (unsigned)NUM_CHANGES);
+
+  Start = Seconds();
+  for (Loop = 0; Loop < BENCH_LOOPS; Loop++)
+  {
+    Row[0] = Loop;
+    Comp_PutLayerRow(CompLayerEffect, Row, Loop % NUM_ROWS);
+    Comp_Compose();
+  }
+  fprintf(stdout, "%.0f ns to recompose after a row changed\n",
+          (Seconds() - Start) / BENCH_LOOPS * 1e9);
+  Start = Seconds();
+  for (Loop = 0; Loop < BENCH_LOOPS; Loop++)
+  {
+    Comp_SetOffset(CompLayerScore, -(int16_t)(Loop % 8), 0);
+    Comp_Compose();
+  }
+  fprintf(stdout, "%.0f ns to recompose after a layer moved\n",
+          (Seconds() - Start) / BENCH_LOOPS * 1e9);
+
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,293 @@
+/****************************************************************************
+ Module
+   DisplayTx.c
+
+ Revision
+   1.0.0
+
+ Description
+   Streams queued latches to the MAX7219 chain from the INT4 (SS rising)
+   interrupt, see DisplayTx.h.
+
+ Notes
+   The queue is an SPSC ring of bytes, a latch being DISPLAY_CHAIN_LEN words.
+   The main loop is the only producer and the interrupt the only consumer;
+   the main loop masks INT4 while it decides whether the transmitter needs
+   starting, so the two never both start a latch.
+   SPISetup_MapSSOutput routes SS to INT4 and sets it for rising edges.
+   A latch longer than the SPI1 FIFO is written 8 words at first and the
+   rest from the SPI1 transmit interrupt, set to fire when the FIFO is half
+   empty, so that SS stays low until the whole latch is out.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 23:20 mp      chains longer than the SPI1 FIFO
+ 10/18/26 22:20 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#ifndef HOST_TEST
+#include <xc.h>
+#include <sys/attribs.h>    // for ISR macros
+#endif
+#include "spsc_ring.h"
+#include "DisplayTx.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define LATCH_BYTES (DISPLAY_CHAIN_LEN * sizeof(uint16_t))
+// the ring storage has to be a power of 2
+#if DISPLAY_TX_LATCHES * DISPLAY_CHAIN_LEN * 2 <= 256
+#define RING_SIZE 256
+#elif DISPLAY_TX_LATCHES * DISPLAY_CHAIN_LEN * 2 <= 512
+#define RING_SIZE 512
+#elif DISPLAY_TX_LATCHES * DISPLAY_CHAIN_LEN * 2 <= 1024
+#define RING_SIZE 1024
+#else
+#error "DISPLAY_CHAIN_LEN is too long"
+#endif
+
+// 16 bit words in the SPI1 enhanced buffer
+#define SPI_FIFO_WORDS 8
+#if DISPLAY_CHAIN_LEN > SPI_FIFO_WORDS
+#define LONG_LATCH
+#endif
+
+// priority of the INT4 and SPI1 interrupts, below the framework tick (3)
+#define DISPLAY_TX_IPL 2
+
+/*---------------------------- Module Functions ---------------------------*/
+static bool StartNextLatch(void);
+static void MaskSSInt(void);
+static void UnmaskSSInt(void);
+static void WriteWords(uint8_t MaxWords);
+
+/*---------------------------- Module Variables ---------------------------*/
+static SPSCRing_t LatchRing;
+static uint8_t LatchStorage[RING_SIZE];
+// the latch being sent and the next word of it to go in the FIFO
+static uint16_t Latch[DISPLAY_CHAIN_LEN];
+static volatile uint8_t NextWord;
+// set while a latch is in the SPI, cleared by the interrupt when the queue
+// runs dry
+static volatile bool Busy;
+static volatile bool Done;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   DisplayTx_Init
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   Empties the queue and enables the INT4 interrupt. SPI1 and the SS output
+   must already be set up.
+ Author
+   M. Peraza, 10/18/26 22:20
+****************************************************************************/
+void DisplayTx_Init(void)
+{
+  SPSCRing_Init(&LatchRing, LatchStorage, sizeof(LatchStorage));
+  Busy = false;
+  Done = false;
+#ifndef HOST_TEST
+  IPC4bits.INT4IP = DISPLAY_TX_IPL;
+  IFS0CLR = _IFS0_INT4IF_MASK;
+  IEC0SET = _IEC0_INT4IE_MASK;
+#ifdef LONG_LATCH
+  // interrupt when the FIFO is half empty, only enabled part way through a
+  // latch
+  SPI1CONbits.STXISEL = 0b10;
+  IPC7bits.SPI1IP = DISPLAY_TX_IPL;
+  IEC1CLR = _IEC1_SPI1TXIE_MASK;
+  IFS1CLR = _IFS1_SPI1TXIF_MASK;
+#endif
+#endif
+}
+
+/****************************************************************************
+ Function
+   DisplayTx_QueueLatch
+
+ Parameters
+   const uint16_t *pWords : DISPLAY_CHAIN_LEN words, for the controller at
+   the far end of the chain first
+
+ Returns
+   bool : false if the queue is full and the latch was not queued
+
+ Description
+   Queues a latch, starting the transmitter if it is idle. Never waits.
+ Author
+   M. Peraza, 10/18/26 22:20
+****************************************************************************/
+bool DisplayTx_QueueLatch(const uint16_t *pWords)
+{
+  if (SPSCRing_Free(&LatchRing) < LATCH_BYTES)
+  {
+    return false;
+  }
+  SPSCRing_PutRange(&LatchRing, (const uint8_t *)pWords, LATCH_BYTES);
+
+  MaskSSInt();
+  if (!Busy)
+  {
+    Busy = StartNextLatch();
+  }
+  UnmaskSSInt();
+  return true;
+}
+
+/****************************************************************************
+ Function
+   DisplayTx_IsBusy
+
+ Parameters
+   None
+
+ Returns
+   bool : true while latches are being sent
+
+ Author
+   M. Peraza, 10/18/26 22:20
+****************************************************************************/
+bool DisplayTx_IsBusy(void)
+{
+  return Busy;
+}
+
+/****************************************************************************
+ Function
+   DisplayTx_CheckDone
+
+ Parameters
+   None
+
+ Returns
+   bool : true, once, after the last queued latch has gone out
+
+ Author
+   M. Peraza, 10/18/26 22:20
+****************************************************************************/
+bool DisplayTx_CheckDone(void)
+{
+  if (Done)
+  {
+    Done = false;
+    return true;
+  }
+  return false;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+#ifndef HOST_TEST
+/****************************************************************************
+ Function
+   DisplayTx_SSRiseIntHandler
+
+ Description
+   SS has risen, so the last latch is in the controllers. Sends the next one
+   or, with the queue empty, marks the transmitter idle and done.
+****************************************************************************/
+void __ISR(_EXTERNAL_4_VECTOR, IPL2AUTO) DisplayTx_SSRiseIntHandler(void)
+{
+  IFS0CLR = _IFS0_INT4IF_MASK;
+#else
+void DisplayTx_SimSSRise(void)
+{
+#endif
+  if (!StartNextLatch())
+  {
+    Busy = false;
+    Done = true;
+  }
+}
+
+#ifdef LONG_LATCH
+#ifndef HOST_TEST
+/****************************************************************************
+ Function
+   DisplayTx_TxIntHandler
+
+ Description
+   The SPI1 FIFO is half empty, tops it up from the latch being sent and
+   turns itself off once the whole latch is in.
+****************************************************************************/
+void __ISR(_SPI_1_VECTOR, IPL2AUTO) DisplayTx_TxIntHandler(void)
+{
+  WriteWords(DISPLAY_CHAIN_LEN);
+  IFS1CLR = _IFS1_SPI1TXIF_MASK;
+#else
+void DisplayTx_SimTxInt(void)
+{
+  // half the FIFO is free when the interrupt fires
+  WriteWords(SPI_FIFO_WORDS / 2);
+#endif
+  if (NextWord == DISPLAY_CHAIN_LEN)
+  {
+#ifndef HOST_TEST
+    IEC1CLR = _IEC1_SPI1TXIE_MASK;
+#endif
+  }
+}
+#elif defined(HOST_TEST)
+void DisplayTx_SimTxInt(void)
+{
+}
+#endif
+
+// moves the next latch into the SPI1 FIFO, false if there is none
+static bool StartNextLatch(void)
+{
+  if (SPSCRing_GetRange(&LatchRing, (uint8_t *)Latch, LATCH_BYTES) == 0)
+  {
+    return false;
+  }
+  NextWord = 0;
+  WriteWords(SPI_FIFO_WORDS);
+#if defined(LONG_LATCH) && !defined(HOST_TEST)
+  // the rest from the transmit interrupt
+  IFS1CLR = _IFS1_SPI1TXIF_MASK;
+  IEC1SET = _IEC1_SPI1TXIE_MASK;
+#endif
+  return true;
+}
+
+// writes words of the latch to the FIFO, no more than MaxWords and, on the
+// PIC32, only while there is room
+static void WriteWords(uint8_t MaxWords)
+{
+  for ( ; (NextWord < DISPLAY_CHAIN_LEN) && (MaxWords > 0); MaxWords--)
+  {
+#ifndef HOST_TEST
+    if (SPI1STATbits.SPITBF)
+    {
+      break;
+    }
+    SPI1BUF = Latch[NextWord++];
+#else
+    DisplayTx_SimWrite(Latch[NextWord++]);
+#endif
+  }
+}
+
+static void MaskSSInt(void)
+{
+#ifndef HOST_TEST
+  IEC0CLR = _IEC0_INT4IE_MASK;
+#endif
+}
+
+static void UnmaskSSInt(void)
+{
+#ifndef HOST_TEST
+  IEC0SET = _IEC0_INT4IE_MASK;
+#endif
+}
+/*------------------------------ End of file ------------------------------*/
@@ -16,6 +16,9 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 20:45 mp      Check4Keystroke passes bytes through the injection
+                        frame parser before treating them as keys
+ 10/18/26 17:20 mp      Check4Keystroke posts whole lines in line mode
  08/06/13 13:36 jec     initial version
 ****************************************************************************/
 
@@ -39,6 +42,8 @@
 // include our own prototypes to insure consistency between header &
 // actual functionsdefinition
 #include "EventCheckers.h"
+// framed events from test rigs arrive mixed in with the keystrokes
+#include "ES_Inject.h"
 
 // This is the event checking function sample. It is not intended to be
 // included in the module. It is only here as a sample to guide you in writing
@@ -92,10 +97,17 @@ bool Check4Lock(void)
  Parameters
    None
  Returns
-   bool: true if a new key was detected & posted
+   bool: true if a new key (or line) was detected & posted
  Description
    checks to see if a new key from the keyboard is detected and, if so,
-   retrieves the key and posts an ES_NewKey event to TestHarnessService0
+   retrieves the key and posts an ES_NewKey event to TestHarnessService0.
+   In terminal line mode it instead posts an ES_NEW_LINE for each completed
+   line, with the handle to pass to Terminal_GetLine as the parameter.
+   Outside of line mode, bytes that belong to an injection frame (see
+   ES_Inject.h) are given to the frame parser, which posts the frame's
+   event, and only the rest become ES_NEW_KEY events. Frame bytes are read
+   until an event is posted or the buffer runs dry, so frames are not held
+   up to one byte per pass
  Notes
    The functions that actually check the serial hardware for characters
    and retrieve them are assumed to be in ES_Port.c
@@ -108,13 +120,35 @@ bool Check4Lock(void)
 ****************************************************************************/
 bool Check4Keystroke(void)
 {
-  if (IsNewKeyReady())   // new key waiting?
+  if (Terminal_IsLineMode())
   {
-    ES_Event_t ThisEvent;
-    ThisEvent.EventType   = ES_NEW_KEY;
-    ThisEvent.EventParam  = GetNewKey();
-    ES_PostAll(ThisEvent);
-    return true;
+    uint16_t LineHandle;
+    if (Terminal_GetNewLine(&LineHandle))   // whole line waiting?
+    {
+      ES_Event_t ThisEvent;
+      ThisEvent.EventType   = ES_NEW_LINE;
+      ThisEvent.EventParam  = LineHandle;
+      ES_PostAll(ThisEvent);
+      return true;
+    }
+    return false;
+  }
+  while (IsNewKeyReady())   // new key waiting?
+  {
+    uint8_t NewKey = GetNewKey();
+    ES_InjectResult_t Injected = ES_Inject_ParseByte(NewKey);
+    if (Injected == INJECT_POSTED)
+    {
+      return true;
+    }
+    if (Injected == INJECT_NOT_MINE)
+    {
+      ES_Event_t ThisEvent;
+      ThisEvent.EventType   = ES_NEW_KEY;
+      ThisEvent.EventParam  = NewKey;
+      ES_PostAll(ThisEvent);
+      return true;
+    }
   }
   return false;
 }
@@ -0,0 +1,116 @@
+/****************************************************************************
+ Module
+   FontGlyphs.c
+
+ Description
+   font4x6 expanded to 8 rows per character, see FontStuff.h.
+
+ Notes
+   Generated by Tools/gen_font_glyphs.py from font4x6 in FontStuff.c, do not
+   edit. FontStuff.c checks it against getFontLine in its host test.
+****************************************************************************/
+#ifndef HOST_TEST
+#include <xc.h>
+#else
+#include <stdint.h>
+#endif
+#include "FontStuff.h"
+
+const uint8_t FontGlyphs[FONT_NUM_GLYPHS][FONT_GLYPH_ROWS] = {
+ { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*SPACE*/
+ { 0x04, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00 },  /*'!'*/
+ { 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*'"'*/
+ { 0x0a, 0x0e, 0x0a, 0x0e, 0x0a, 0x00, 0x00, 0x00 },  /*'#'*/
+ { 0x06, 0x0c, 0x0e, 0x06, 0x0c, 0x00, 0x00, 0x00 },  /*'$'*/
+ { 0x0a, 0x02, 0x04, 0x08, 0x0a, 0x00, 0x00, 0x00 },  /*'%'*/
+ { 0x04, 0x0a, 0x04, 0x0a, 0x0c, 0x00, 0x00, 0x00 },  /*'&'*/
+ { 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*'''*/
+ { 0x02, 0x04, 0x04, 0x04, 0x02, 0x00, 0x00, 0x00 },  /*'('*/
+ { 0x04, 0x02, 0x02, 0x02, 0x04, 0x00, 0x00, 0x00 },  /*')'*/
+ { 0x00, 0x0a, 0x04, 0x0a, 0x00, 0x00, 0x00, 0x00 },  /*'*'*/
+ { 0x00, 0x04, 0x0e, 0x04, 0x00, 0x00, 0x00, 0x00 },  /*'+'*/
+ { 0x00, 0x00, 0x00, 0x04, 0x08, 0x00, 0x00, 0x00 },  /*','*/
+ { 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*'-'*/
+ { 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00 },  /*'.'*/
+ { 0x02, 0x02, 0x04, 0x08, 0x08, 0x00, 0x00, 0x00 },  /*'/'*/
+ { 0x06, 0x0a, 0x0a, 0x0a, 0x0c, 0x00, 0x00, 0x00 },  /*'0'*/
+ { 0x04, 0x0c, 0x04, 0x04, 0x0e, 0x00, 0x00, 0x00 },  /*'1'*/
+ { 0x0c, 0x02, 0x06, 0x08, 0x0e, 0x00, 0x00, 0x00 },  /*'2'*/
+ { 0x0c, 0x02, 0x04, 0x02, 0x0c, 0x00, 0x00, 0x00 },  /*'3'*/
+ { 0x08, 0x08, 0x0a, 0x0e, 0x02, 0x00, 0x00, 0x00 },  /*'4'*/
+ { 0x0e, 0x08, 0x0e, 0x02, 0x0c, 0x00, 0x00, 0x00 },  /*'5'*/
+ { 0x06, 0x08, 0x0e, 0x0a, 0x0c, 0x00, 0x00, 0x00 },  /*'6'*/
+ { 0x0e, 0x02, 0x04, 0x08, 0x08, 0x00, 0x00, 0x00 },  /*'7'*/
+ { 0x06, 0x0a, 0x0e, 0x0a, 0x0c, 0x00, 0x00, 0x00 },  /*'8'*/
+ { 0x06, 0x0a, 0x0e, 0x02, 0x0c, 0x00, 0x00, 0x00 },  /*'9'*/
+ { 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00 },  /*':'*/
+ { 0x00, 0x04, 0x00, 0x04, 0x08, 0x00, 0x00, 0x00 },  /*';'*/
+ { 0x02, 0x04, 0x08, 0x04, 0x02, 0x00, 0x00, 0x00 },  /*'<'*/
+ { 0x00, 0x0e, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00 },  /*'='*/
+ { 0x08, 0x04, 0x02, 0x04, 0x08, 0x00, 0x00, 0x00 },  /*'>'*/
+ { 0x0e, 0x02, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00 },  /*'?'*/
+ { 0x04, 0x0a, 0x0a, 0x08, 0x06, 0x00, 0x00, 0x00 },  /*'@'*/
+ { 0x06, 0x0a, 0x0e, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'A'*/
+ { 0x0c, 0x0a, 0x0c, 0x0a, 0x0c, 0x00, 0x00, 0x00 },  /*'B'*/
+ { 0x06, 0x08, 0x08, 0x08, 0x06, 0x00, 0x00, 0x00 },  /*'C'*/
+ { 0x0c, 0x0a, 0x0a, 0x0a, 0x0c, 0x00, 0x00, 0x00 },  /*'D'*/
+ { 0x06, 0x08, 0x0e, 0x08, 0x0e, 0x00, 0x00, 0x00 },  /*'E'*/
+ { 0x06, 0x08, 0x0e, 0x08, 0x08, 0x00, 0x00, 0x00 },  /*'F'*/
+ { 0x06, 0x08, 0x0a, 0x0a, 0x06, 0x00, 0x00, 0x00 },  /*'G'*/
+ { 0x0a, 0x0a, 0x0e, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'H'*/
+ { 0x0e, 0x04, 0x04, 0x04, 0x0e, 0x00, 0x00, 0x00 },  /*'I'*/
+ { 0x06, 0x02, 0x02, 0x0a, 0x04, 0x00, 0x00, 0x00 },  /*'J'*/
+ { 0x0a, 0x0a, 0x0c, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'K'*/
+ { 0x08, 0x08, 0x08, 0x08, 0x0e, 0x00, 0x00, 0x00 },  /*'L'*/
+ { 0x0a, 0x0e, 0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'M'*/
+ { 0x0c, 0x0a, 0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'N'*/
+ { 0x04, 0x0a, 0x0a, 0x0a, 0x04, 0x00, 0x00, 0x00 },  /*'O'*/
+ { 0x0c, 0x0a, 0x0e, 0x08, 0x08, 0x00, 0x00, 0x00 },  /*'P'*/
+ { 0x06, 0x0a, 0x0a, 0x0e, 0x06, 0x00, 0x00, 0x00 },  /*'Q'*/
+ { 0x06, 0x0a, 0x0c, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'R'*/
+ { 0x06, 0x08, 0x04, 0x02, 0x0c, 0x00, 0x00, 0x00 },  /*'S'*/
+ { 0x0e, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00 },  /*'T'*/
+ { 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x00, 0x00, 0x00 },  /*'U'*/
+ { 0x0a, 0x0a, 0x0a, 0x0a, 0x04, 0x00, 0x00, 0x00 },  /*'V'*/
+ { 0x0a, 0x0a, 0x0a, 0x0e, 0x0a, 0x00, 0x00, 0x00 },  /*'W'*/
+ { 0x0a, 0x0a, 0x04, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'X'*/
+ { 0x0a, 0x0a, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00 },  /*'Y'*/
+ { 0x0e, 0x02, 0x04, 0x08, 0x0e, 0x00, 0x00, 0x00 },  /*'Z'*/
+ { 0x06, 0x04, 0x04, 0x04, 0x06, 0x00, 0x00, 0x00 },  /*'['*/
+ { 0x08, 0x08, 0x04, 0x02, 0x02, 0x00, 0x00, 0x00 },  /*'\'*/
+ { 0x06, 0x02, 0x02, 0x02, 0x06, 0x00, 0x00, 0x00 },  /*']'*/
+ { 0x04, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*'^'*/
+ { 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00 },  /*'_'*/
+ { 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*'`'*/
+ { 0x00, 0x06, 0x0a, 0x0a, 0x06, 0x00, 0x00, 0x00 },  /*'a'*/
+ { 0x08, 0x0c, 0x0a, 0x0a, 0x0c, 0x00, 0x00, 0x00 },  /*'b'*/
+ { 0x00, 0x06, 0x08, 0x08, 0x06, 0x00, 0x00, 0x00 },  /*'c'*/
+ { 0x02, 0x06, 0x0a, 0x0a, 0x06, 0x00, 0x00, 0x00 },  /*'d'*/
+ { 0x00, 0x06, 0x0a, 0x0c, 0x06, 0x00, 0x00, 0x00 },  /*'e'*/
+ { 0x04, 0x0a, 0x08, 0x0c, 0x08, 0x00, 0x00, 0x00 },  /*'f'*/
+ { 0x00, 0x04, 0x0a, 0x06, 0x02, 0x0c, 0x00, 0x00 },  /*'g'*/
+ { 0x08, 0x08, 0x0c, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'h'*/
+ { 0x04, 0x00, 0x04, 0x04, 0x02, 0x00, 0x00, 0x00 },  /*'i'*/
+ { 0x00, 0x04, 0x00, 0x04, 0x04, 0x08, 0x00, 0x00 },  /*'j'*/
+ { 0x08, 0x0a, 0x0c, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'k'*/
+ { 0x04, 0x04, 0x04, 0x04, 0x02, 0x00, 0x00, 0x00 },  /*'l'*/
+ { 0x00, 0x0a, 0x0e, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'m'*/
+ { 0x00, 0x0c, 0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'n'*/
+ { 0x00, 0x04, 0x0a, 0x0a, 0x04, 0x00, 0x00, 0x00 },  /*'o'*/
+ { 0x00, 0x0c, 0x0a, 0x0a, 0x0c, 0x08, 0x00, 0x00 },  /*'p'*/
+ { 0x00, 0x06, 0x0a, 0x0a, 0x06, 0x02, 0x00, 0x00 },  /*'q'*/
+ { 0x00, 0x0a, 0x0c, 0x08, 0x08, 0x00, 0x00, 0x00 },  /*'r'*/
+ { 0x00, 0x06, 0x0c, 0x02, 0x0c, 0x00, 0x00, 0x00 },  /*'s'*/
+ { 0x08, 0x0c, 0x08, 0x08, 0x06, 0x00, 0x00, 0x00 },  /*'t'*/
+ { 0x00, 0x0a, 0x0a, 0x0a, 0x06, 0x00, 0x00, 0x00 },  /*'u'*/
+ { 0x00, 0x0a, 0x0a, 0x0a, 0x0c, 0x00, 0x00, 0x00 },  /*'v'*/
+ { 0x00, 0x0a, 0x0a, 0x0e, 0x0a, 0x00, 0x00, 0x00 },  /*'w'*/
+ { 0x00, 0x0a, 0x04, 0x0a, 0x0a, 0x00, 0x00, 0x00 },  /*'x'*/
+ { 0x00, 0x0a, 0x0a, 0x06, 0x02, 0x04, 0x00, 0x00 },  /*'y'*/
+ { 0x00, 0x0e, 0x02, 0x04, 0x0e, 0x00, 0x00, 0x00 },  /*'z'*/
+ { 0x06, 0x04, 0x0c, 0x04, 0x06, 0x00, 0x00, 0x00 },  /*'{'*/
+ { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00 },  /*'|'*/
+ { 0x0c, 0x04, 0x06, 0x04, 0x0c, 0x00, 0x00, 0x00 },  /*'}'*/
+ { 0x04, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*'~'*/
+ { 0x04, 0x0a, 0x0a, 0x0e, 0x00, 0x00, 0x00, 0x00 }   /*''*/
+};
@@ -1,4 +1,9 @@
+#ifndef HOST_TEST
 #include <xc.h>
+#else
+#include <stdint.h>
+#include <stdbool.h>
+#endif
 #include "FontStuff.h"
 //Copyright <2010> <Robey Pointer, https://robey.lag.net/> =========>
 // 
@@ -137,4 +142,97 @@ uint8_t getFontLine(unsigned char data, int line_num) {
         pixel = ((font4x6[index][1])) >> 1;
     }
     return pixel & 0xE;
-}//<=============================================================================
\ No newline at end of file
+}//<=============================================================================
+
+/****************************************************************************
+ Function
+   getFontGlyph
+
+ Parameters
+   unsigned char data : the character
+
+ Returns
+   const uint8_t * : its FONT_GLYPH_ROWS rows from FontGlyphs, row 0 first
+
+ Description
+   The expanded form of getFontLine, for drawing a whole character with no
+   decoding. Characters outside the font come back as a space.
+ Author
+   M. Peraza, 10/18/26 22:40
+****************************************************************************/
+const uint8_t *getFontGlyph(unsigned char data)
+{
+    uint8_t index = data - FONT_FIRST_CHAR;
+
+    if (index >= FONT_NUM_GLYPHS) {
+        index = 0;
+    }
+    return FontGlyphs[index];
+}
+
+/****************************************************************************
+ host test harness, checks FontGlyphs pixel for pixel against getFontLine
+ and times drawing glyphs both ways
+ gcc -O2 -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/FontStuff.c ProjectSource/FontGlyphs.c -o font_test
+****************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include "host_test.h"
+
+#define BENCH_GLYPHS 20000000u
+
+int main(void)
+{
+    // stands in for the first module of DM_Display, 1 byte per row
+    static volatile uint8_t Frame[FONT_GLYPH_ROWS];
+    const uint8_t *pGlyph;
+    double Start;
+    double Decoded;
+    double Expanded;
+    uint32_t Count;
+    unsigned Char;
+    uint8_t Row;
+    bool Passed = true;
+
+    for (Char = FONT_FIRST_CHAR; Char < FONT_FIRST_CHAR + FONT_NUM_GLYPHS;
+         Char++) {
+        pGlyph = getFontGlyph(Char);
+        for (Row = 0; Row < FONT_GLYPH_ROWS; Row++) {
+            if (pGlyph[Row] != getFontLine(Char, Row)) {
+                fprintf(stdout, "failed: '%c' row %u\n", Char, Row);
+                Passed = false;
+            }
+        }
+    }
+    if (getFontGlyph(0x80) != getFontGlyph(' ')) {
+        fprintf(stdout, "failed: out of range character\n");
+        Passed = false;
+    }
+
+    // each way ORs glyphs into the frame the way DM_AddChar2Display does
+    Start = Seconds();
+    for (Count = 0; Count < BENCH_GLYPHS; Count++) {
+        Char = FONT_FIRST_CHAR + Count % FONT_NUM_GLYPHS;
+        for (Row = 0; Row < FONT_GLYPH_ROWS; Row++) {
+            Frame[Row] |= getFontLine(Char, Row);
+        }
+    }
+    Decoded = Seconds() - Start;
+    Start = Seconds();
+    for (Count = 0; Count < BENCH_GLYPHS; Count++) {
+        pGlyph = getFontGlyph(FONT_FIRST_CHAR + Count % FONT_NUM_GLYPHS);
+        for (Row = 0; Row < FONT_GLYPH_ROWS; Row++) {
+            Frame[Row] |= pGlyph[Row];
+        }
+    }
+    Expanded = Seconds() - Start;
+    fprintf(stdout, "getFontLine  %6.1f M glyphs/s\n",
+        BENCH_GLYPHS / Decoded / 1e6);
+    fprintf(stdout, "getFontGlyph %6.1f M glyphs/s\n",
+        BENCH_GLYPHS / Expanded / 1e6);
+
+    puts(Passed ? "PASS" : "FAIL");
+    return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
@@ -0,0 +1,277 @@
+/****************************************************************************
+ Module
+   GameTelemetry.c
+
+ Revision
+   1.0.0
+
+ Description
+   Builds the game telemetry records described in GameTelemetry.h.
+   ModeServiceFSM reports the start and end of each game and each round;
+   the reaction time is the time from the module lighting up to the end of
+   the round.
+
+ Notes
+   Times come from ES_Timer_GetTime, so they wrap after 65.5 s. The longest
+   round is 8 s and a game is 60 s, so neither wraps.
+   Sessions are numbered from 1 at power up.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      the harness uses Check from host_test.h
+ 10/18/26 21:40 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Inject.h"
+#include "terminal.h"
+#include "GameTelemetry.h"
+
+#ifdef GAME_TELEMETRY
+/*----------------------------- Module Defines ----------------------------*/
+// sync, length, type, session, up to 5 payload bytes, CRC
+#define TELEM_MAX_RECORD  11
+#define TELEM_HEADER_LEN  5
+
+/*---------------------------- Module Functions ---------------------------*/
+static void SendRecord(uint8_t Type, const uint8_t *pPayload, uint8_t Length);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint16_t Session;
+static uint16_t GameStartTime;
+static uint16_t RoundStartTime;
+static uint8_t  RoundModule;
+static uint8_t  RoundNumber;
+static bool     RoundOpen;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   Telemetry_GameStart
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   Starts a new session and sends its TELEM_GAME_START record.
+ Author
+   M. Peraza, 10/18/26 21:40
+****************************************************************************/
+void Telemetry_GameStart(void)
+{
+  Session++;
+  GameStartTime = ES_Timer_GetTime();
+  RoundNumber = 0;
+  RoundOpen = false;
+  SendRecord(TELEM_GAME_START, NULL, 0);
+}
+
+/****************************************************************************
+ Function
+   Telemetry_RoundStart
+
+ Parameters
+   uint8_t Module : the Module_t that was just lit up
+
+ Returns
+   nothing
+
+ Description
+   Notes the module and the time; the record is sent when the round ends.
+ Author
+   M. Peraza, 10/18/26 21:40
+****************************************************************************/
+void Telemetry_RoundStart(uint8_t Module)
+{
+  RoundStartTime = ES_Timer_GetTime();
+  RoundModule = Module;
+  RoundNumber++;
+  RoundOpen = true;
+}
+
+/****************************************************************************
+ Function
+   Telemetry_RoundEnd
+
+ Parameters
+   RoundOutcome_t Outcome : how the round ended
+
+ Returns
+   nothing
+
+ Description
+   Sends the TELEM_ROUND record for the round in progress, if there is one.
+ Author
+   M. Peraza, 10/18/26 21:40
+****************************************************************************/
+void Telemetry_RoundEnd(RoundOutcome_t Outcome)
+{
+  uint8_t Payload[5];
+  uint16_t Reaction;
+
+  if (!RoundOpen)
+  {
+    return;
+  }
+  RoundOpen = false;
+  Reaction = ES_Timer_GetTime() - RoundStartTime;
+  Payload[0] = RoundNumber;
+  Payload[1] = RoundModule;
+  Payload[2] = (uint8_t)Outcome;
+  Payload[3] = (uint8_t)Reaction;
+  Payload[4] = (uint8_t)(Reaction >> 8);
+  SendRecord(TELEM_ROUND, Payload, sizeof(Payload));
+}
+
+/****************************************************************************
+ Function
+   Telemetry_GameEnd
+
+ Parameters
+   uint32_t Points : the final score
+
+ Returns
+   nothing
+
+ Description
+   Sends the TELEM_GAME_END record for the session.
+ Author
+   M. Peraza, 10/18/26 21:40
+****************************************************************************/
+void Telemetry_GameEnd(uint32_t Points)
+{
+  uint8_t Payload[5];
+  uint16_t GameLength = ES_Timer_GetTime() - GameStartTime;
+
+  if (Points > UINT16_MAX)
+  {
+    Points = UINT16_MAX;
+  }
+  Payload[0] = RoundNumber;
+  Payload[1] = (uint8_t)Points;
+  Payload[2] = (uint8_t)(Points >> 8);
+  Payload[3] = (uint8_t)GameLength;
+  Payload[4] = (uint8_t)(GameLength >> 8);
+  SendRecord(TELEM_GAME_END, Payload, sizeof(Payload));
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+static void SendRecord(uint8_t Type, const uint8_t *pPayload, uint8_t Length)
+{
+  uint8_t Record[TELEM_MAX_RECORD];
+  uint8_t i;
+
+  Record[0] = TELEM_SYNC;
+  Record[1] = Length + 3;   // type and session
+  Record[2] = Type;
+  Record[3] = (uint8_t)Session;
+  Record[4] = (uint8_t)(Session >> 8);
+  for (i = 0; i < Length; i++)
+  {
+    Record[TELEM_HEADER_LEN + i] = pPayload[i];
+  }
+  Record[TELEM_HEADER_LEN + Length] =
+      ES_Inject_CRC8(&Record[1], TELEM_HEADER_LEN - 1 + Length);
+  Terminal_WriteRecord(Record, TELEM_HEADER_LEN + Length + 1);
+}
+
+/***************************************************************************
+ module test harness, plays two short games and checks the records
+ gcc -c -IFrameworkHeaders FrameworkSource/spsc_ring.c
+ gcc -DHOST_TEST -c -IFrameworkHeaders -IProjectHeaders \
+     FrameworkSource/terminal.c FrameworkSource/dbprintf.c \
+     FrameworkSource/ES_Inject.c
+ gcc -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/GameTelemetry.c terminal.o dbprintf.o ES_Inject.o \
+     spsc_ring.o -o telemetry_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+
+static uint16_t SimTime;
+
+uint16_t ES_Timer_GetTime(void)
+{
+  return SimTime;
+}
+
+// ES_Inject.c posts events, these games never send it any
+bool ES_PostToService(uint8_t WhichService, ES_Event_t TheEvent)
+{
+  return false;
+}
+
+bool ES_PostAll(ES_Event_t TheEvent)
+{
+  return false;
+}
+
+int main(void)
+{
+  static const uint8_t Expected[] =
+  {
+    // session 1 start
+    0xA6, 3, TELEM_GAME_START, 1, 0,
+    // round 1, module 2, hit after 1234 ms
+    0xA6, 8, TELEM_ROUND, 1, 0, 1, 2, RoundHit, 0xD2, 0x04,
+    // round 2, module 0, timed out after 8000 ms
+    0xA6, 8, TELEM_ROUND, 1, 0, 2, 0, RoundTimedOut, 0x40, 0x1F,
+    // end, 2 rounds, 1 point, 60000 ms
+    0xA6, 8, TELEM_GAME_END, 1, 0, 2, 1, 0, 0x60, 0xEA,
+  };
+  uint8_t Stream[128];
+  size_t Length;
+  size_t Offset;
+  size_t i;
+  size_t j;
+  bool Passed = true;
+
+  Terminal_HWInit();
+  Telemetry_GameStart();
+  Telemetry_RoundStart(2);
+  SimTime += 1234;
+  Telemetry_RoundEnd(RoundHit);
+  Telemetry_RoundEnd(RoundHit);   // no round open, nothing sent
+  Telemetry_RoundStart(0);
+  SimTime += 8000;
+  Telemetry_RoundEnd(RoundTimedOut);
+  SimTime += 60000 - 9234;
+  Telemetry_GameEnd(1);
+
+  Length = Terminal_SimDrain(Stream, sizeof(Stream));
+  // compare everything but the CRCs, then check each CRC
+  Passed &= Check(Length == sizeof(Expected) + 4, "record lengths");
+  for (i = 0, j = 0, Offset = 0; (i < sizeof(Expected)) && Passed; i++, j++)
+  {
+    if ((i > 0) && (Expected[i] == TELEM_SYNC))
+    {
+      Passed &= Check(Stream[j] ==
+          ES_Inject_CRC8(&Stream[Offset + 1], j - Offset - 1), "CRC");
+      j++;
+      Offset = j;
+    }
+    Passed &= Check(Stream[j] == Expected[i], "record contents");
+  }
+  Passed &= Check(Stream[j] ==
+      ES_Inject_CRC8(&Stream[Offset + 1], j - Offset - 1), "last CRC");
+
+  // the next game is the next session
+  Telemetry_GameStart();
+  Length = Terminal_SimDrain(Stream, sizeof(Stream));
+  Passed &= Check((Length == 6) && (Stream[3] == 2), "second session");
+
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+#endif // GAME_TELEMETRY
+/*------------------------------ End of file ------------------------------*/
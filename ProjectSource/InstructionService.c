@@ -24,8 +24,10 @@
 #include "LEDService.h"
 #include "terminal.h"
 #include "dbprintf.h"
+#include "TextComposer.h"
 
 /*----------------------------- Module Defines ----------------------------*/
+#define POINTS_WIDTH 2
 
 /*---------------------------- Module Functions ---------------------------*/
 /* prototypes for private functions for this machine.They should be functions
@@ -43,6 +45,20 @@ static uint8_t MyPriority;
 
 unsigned char Instruction[50];
 
+// the name shown for each module and the width of its column, in Module_t
+// order
+static const struct
+{
+  const char *pName;
+  uint8_t Width;
+}InstructionFields[] =
+{
+  { "Touch", 11 },
+  { "Shake", 11 },
+  { "Squeeze", 12 },
+  { "Wave", 10 },
+};
+
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
  Function
@@ -118,6 +134,7 @@ ES_Event_t RunInstructionService(ES_Event_t ThisEvent)
 
   ES_Event_t LEDEvent;
   LEDEvent.EventType = ES_ADD_STRING;
+  LEDEvent.EventParam = 0;    // the marquee keeps its speed
 
   switch (CurrentState)
   {
@@ -207,52 +224,20 @@ InstructionState_t QueryInstructionService(void)
 
  Description
      Updates the Instruction String depending on the current active module and 
-     point total
+     point total. The module name is padded to its column width so that the
+     points land in the same place on the display whatever the count.
 ****************************************************************************/
 static void GetInstruction(Module_t Module)
 {
-    if (Module == Touch)
-    {
-        if (Points >= 10)
-        {
-            snprintf(Instruction, 50, "Touch      %dpt", Points);
-        }
-        else
-        {
-            snprintf(Instruction, 50, "Touch       %dpt", Points);
-        }
-    }
-    if (Module == Squeeze)
-    {
-        if (Points >= 10)
-        {
-            snprintf(Instruction, 50, "Squeeze     %dpt", Points);
-        }
-        else
-        {
-            snprintf(Instruction, 50, "Squeeze      %dpt", Points);
-        }
-    }
-    if (Module == Shake)
-    {
-        if (Points >= 10)
-        {
-            snprintf(Instruction, 50, "Shake      %dpt", Points);
-        }
-        else
-        {
-            snprintf(Instruction, 50, "Shake       %dpt", Points);
-        }
-    }
-    if (Module == Wave)
+    TextComposer_t Line;
+
+    if (Module >= ARRAY_SIZE(InstructionFields))
     {
-        if (Points >= 10)
-        {
-            snprintf(Instruction, 50, "Wave      %dpt", Points);
-        }
-        else
-        {
-            snprintf(Instruction, 50, "Wave       %dpt", Points);
-        }
+        return;
     }
+    TC_Begin(&Line, (char *)Instruction, sizeof(Instruction));
+    TC_PutText(&Line, InstructionFields[Module].pName,
+        InstructionFields[Module].Width);
+    TC_PutUnsigned(&Line, Points, POINTS_WIDTH);
+    TC_PutText(&Line, "pt", 0);
 }
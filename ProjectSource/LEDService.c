@@ -10,6 +10,15 @@
    Gen2 Events and Services Framework.
 
  Notes
+   The display pipeline has three stages: compose into the display buffer
+   (ComposeFrame), commit it as the next frame (DM_CommitFrame), and send
+   the changed rows in the background (DM_StartDisplayUpdate, DisplayTx).
+   Text and the marquee are drawn on the text layer of the compositor and
+   the points from ES_SHOW_SCORE on the score layer, right aligned over the
+   text. Animations from AnimPlayer play on the effect layer, a frame every
+   AnimTimer timeout.
+   A frame composed while another is being sent waits in the display
+   buffer, latest wins, until ES_DISPLAY_DONE.
 
 ****************************************************************************/
 /*----------------------------- Include Files -----------------------------*/
@@ -20,24 +29,37 @@
 
 // Hardware
 #include <xc.h>
+#include <string.h>
 //#include <proc/p32mx170f256b.h>
 
 // Event & Services Framework
 #include "ES_Configure.h"
 #include "ES_Framework.h"
-#include "ES_DeferRecall.h"
 #include "ES_Events.h"
 #include "ES_Port.h"
 #include "terminal.h"
 #include "dbprintf.h"
+#define ES_LOG_CHANNEL LOG_CH_LED
+#define ES_LOG_LEVEL   LOG_LEVEL_LED
+#include "ES_Log.h"
 
 #include "DM_Display.h"
 #include "FontStuff.h"
 #include "PIC32_SPI_HAL.h"
+#include "DisplayTx.h"
+#include "Marquee.h"
+#include "Compositor.h"
+#include "AnimPlayer.h"
+#include "TextComposer.h"
 #include "InstructionService.h"
 
 /*----------------------------- Module Defines ----------------------------*/
 
+// characters that fit across the display, longer strings scroll
+#define DISPLAY_CHARS  (DM_NUM_MODULES * 2)
+// the score, as "NNpts"
+#define SCORE_CHARS    8
+
 #define ENTER_POST     ((MyPriority<<3)|0)
 #define ENTER_RUN      ((MyPriority<<3)|1)
 #define ENTER_TIMEOUT  ((MyPriority<<3)|2)
@@ -46,13 +68,17 @@
 /* prototypes for private functions for this service.They should be functions
    relevant to the behavior of this service
 */
+static bool ComposeFrame(ES_Event_t ThisEvent);
 
 /*---------------------------- Module Variables ---------------------------*/
 static TemplateState_t CurrentState;
 // with the introduction of Gen2, we need a module level Priority variable
 static uint8_t MyPriority;
-// add a deferral queue for up to 3 pending deferrals +1 to allow for overhead
-static ES_Event_t DeferralQueue[7 + 1];
+// set when the display buffer has been drawn on while the last frame was
+// still being sent
+static bool FramePending;
+// the characters on the text layer, right aligned, ES_ADD_CHAR adds to it
+static unsigned char TextLine[DISPLAY_CHARS + 1];
 
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
@@ -82,19 +108,15 @@ bool InitLEDService(uint8_t Priority)
   // When doing testing, it is useful to announce just which program
   // is running.
   
-  clrScrn();
-  puts("\rStarting LED Service for \r");
-  DB_printf( "the 2nd Generation Events & Services Framework V2.4\r\n");
-  DB_printf( "compiled at %s on %s\n", __TIME__, __DATE__);
-  DB_printf( "\n\r\n");
-  DB_printf( "Press any key to post key-stroke events to Service 0\n\r");
+  LOG_INFO("\x1b[2J\rStarting LED Service for \r\n");
+  LOG_INFO("the 2nd Generation Events & Services Framework V2.4\r\n");
+  LOG_INFO("compiled at %s on %s\n", __TIME__, __DATE__);
+  LOG_INFO("\n\r\n");
+  LOG_INFO("Press ':' for the shell, 'help' lists its commands\n\r");
 
   /********************************************
    in here you write your initialization code
    *******************************************/
-  // initialize deferral queue for testing Deferal function
-  ES_InitDeferralQueueWith(DeferralQueue, ARRAY_SIZE(DeferralQueue));
-  
   //Initialize SPI
   #define WhichModule SPI_SPI1
   #define WhichPhase SPI_SMP_MID
@@ -120,10 +142,10 @@ bool InitLEDService(uint8_t Priority)
   SPISetup_SetXferWidth(WhichModule, DataWidth);
   SPISetup_EnableSPI(WhichModule);
   
-  IFS0CLR = _IFS0_INT4IF_MASK; //clear flags
-  
-  //Initialize Screen
-  while (false == DM_TakeInitDisplayStep()){}
+  //Initialize Screen, the display transmitter sends it from here on
+  DisplayTx_Init();
+  DM_StartInitDisplay();
+  Comp_Init();
   
   // initialize the Short timer system for channel A
   //ES_ShortTimerInit(MyPriority, SHORT_TIMER_UNUSED);
@@ -164,7 +186,7 @@ bool InitLEDService(uint8_t Priority)
 
 /****************************************************************************
  Function
-    RunTestHarnessService0
+    RunLEDService
 
  Parameters
    ES_Event : the event to process
@@ -173,7 +195,12 @@ bool InitLEDService(uint8_t Priority)
    ES_Event, ES_NO_EVENT if no error ES_ERROR otherwise
 
  Description
-   add your description here
+   The display pipeline. Drawing events are composed into the display
+   (back) buffer straight away, in either state. In Idle the frame is then
+   committed and handed to the transmitter; in Display, while the last
+   frame is still going out, it is only marked pending, and is committed
+   on ES_DISPLAY_DONE. Whatever was drawn last by then is what gets sent,
+   however many events came in meanwhile.
  Notes
 
  Author
@@ -183,7 +210,6 @@ ES_Event_t RunLEDService(ES_Event_t ThisEvent)
 {
   ES_Event_t ReturnEvent;
   ReturnEvent.EventType = ES_NO_EVENT; // assume no errors
-  static char DeferredChar = '1';
 
   switch (CurrentState)
   {
@@ -198,59 +224,38 @@ ES_Event_t RunLEDService(ES_Event_t ThisEvent)
 
     case Idle:
     {
-        switch (ThisEvent.EventType)
+      // compose, commit, transmit
+      if (ComposeFrame(ThisEvent))
+      {
+        DM_CommitFrame();
+        if (DM_StartDisplayUpdate())
         {
-            //Adds Char to Display
-            case ES_ADD_CHAR:
-            {
-                CurrentState = Display;
-                DM_ScrollDisplayBuffer(4);
-                DM_AddChar2Display(ThisEvent.EventParam);
-            }
-            break;
-            
-            //Adds String to Display
-            case ES_ADD_STRING:
-            {
-                CurrentState = Display;
-                DM_AddString2Display(Instruction);
-            }
-            break;
-            
-            defaul:
-                ;
-        }  
+          CurrentState = Display;
+        }
+      }
     }
+    break;
 
     case Display:        
     {
-      switch (ThisEvent.EventType)
+      if (ThisEvent.EventType == ES_DISPLAY_DONE)
       {
-        case ES_ADD_CHAR: 
-
-        { 
-            if (false == DM_TakeDisplayUpdateStep()){
-                ES_PostToService(MyPriority, ThisEvent);
-            } else {
-                CurrentState = Idle;
-            }
+        // commit what was drawn meanwhile, and send it along with any rows
+        // that did not fit in the transmitter queue last time
+        if (FramePending)
+        {
+          DM_CommitFrame();
+          FramePending = false;
         }
-        break;
-        
-        case ES_ADD_STRING:
+        if (false == DM_StartDisplayUpdate())
         {
-            if (false == DM_TakeDisplayUpdateStep()){
-                ES_PostToService(MyPriority, ThisEvent);
-            } else {
-                DM_ClearDisplayBuffer();
-                CurrentState = Idle;
-            }
+          CurrentState = Idle;
         }
-
-        // repeat cases as required for relevant events
-        default:
-          ;
-      }  // end switch on CurrentEvent
+      }
+      else if (ComposeFrame(ThisEvent))
+      {
+        FramePending = true;
+      }
     }
     break;
     // repeat state pattern as required for other states
@@ -260,6 +265,187 @@ ES_Event_t RunLEDService(ES_Event_t ThisEvent)
   return ReturnEvent;
 }
 
+/****************************************************************************
+ Function
+    CheckDisplayDone
+
+ Parameters
+    None
+
+ Returns
+    bool, true if the display transmitter has just finished
+
+ Description
+    Event checker for the display transmitter. Its interrupt only sets a
+    flag, this posts ES_DISPLAY_DONE to the LED service from the main loop.
+    If the queue is full the event is held and posted on a later pass, as
+    the service stays in Display until it gets it.
+ Author
+    M. Peraza, 10/18/26 22:20
+****************************************************************************/
+bool CheckDisplayDone(void)
+{
+  static bool DonePending = false;
+  ES_Event_t ThisEvent;
+
+  if (DisplayTx_CheckDone())
+  {
+    DonePending = true;
+  }
+  if (DonePending)
+  {
+    ThisEvent.EventType = ES_DISPLAY_DONE;
+    if (PostLEDService(ThisEvent))
+    {
+      DonePending = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+    ComposeFrame
+
+ Parameters
+    ES_Event_t ThisEvent : the event to draw
+
+ Returns
+    bool, true if the display buffer was drawn on
+
+ Description
+    The compose stage: draws a drawing event on the text layer and composes
+    the layers into the display buffer. A string replaces the text; one that
+    is too long for the display starts the marquee instead, which then draws
+    each column on a MarqueeTimer timeout, and a non zero parameter sets the
+    time for each column. A character is added to the end of the text,
+    pushing it left. The score is drawn on its own layer. An animation draws
+    a frame on each AnimTimer timeout until it is stopped or, if it does not
+    loop, ends.
+****************************************************************************/
+static bool ComposeFrame(ES_Event_t ThisEvent)
+{
+  bool ReturnVal = false;
+  size_t Length;
+  TextComposer_t Score;
+  char ScoreLine[SCORE_CHARS + 1];
+
+  switch (ThisEvent.EventType)
+  {
+    //Adds Char to Display
+    case ES_ADD_CHAR:
+    {
+      Marquee_Stop();
+      Length = strlen((char *)TextLine);
+      if (Length == DISPLAY_CHARS)
+      {
+        memmove(TextLine, TextLine + 1, --Length);
+      }
+      TextLine[Length] = (unsigned char)ThisEvent.EventParam;
+      TextLine[Length + 1] = '\0';
+      Comp_DrawString(CompLayerText, TextLine, DM_AlignRight);
+      ReturnVal = true;
+    }
+    break;
+
+    //Shows a String, scrolling it if it is too long
+    case ES_ADD_STRING:
+    {
+      // a non zero parameter is the ms for each column of the marquee
+      if (ThisEvent.EventParam != 0)
+      {
+        Marquee_SetColumnMs(ThisEvent.EventParam);
+      }
+      if (strlen((char *)Instruction) > DISPLAY_CHARS)
+      {
+        // the same message again carries on where it was
+        if (Marquee_Start(Instruction))
+        {
+          TextLine[0] = '\0';
+          ES_Timer_InitTimer(MarqueeTimer, 1);
+        }
+      }
+      else
+      {
+        Marquee_Stop();
+        ES_Timer_StopTimer(MarqueeTimer);
+        strcpy((char *)TextLine, (char *)Instruction);
+        Comp_DrawString(CompLayerText, TextLine, DM_AlignRight);
+        ReturnVal = true;
+      }
+    }
+    break;
+
+    //Moves the marquee on a column
+    case ES_TIMEOUT:
+    {
+      if ((ThisEvent.EventParam == MarqueeTimer) && Marquee_IsRunning())
+      {
+        ES_Timer_InitTimer(MarqueeTimer, Marquee_GetColumnMs());
+        Marquee_Step();
+        ReturnVal = true;
+      }
+      else if ((ThisEvent.EventParam == AnimTimer) && Anim_Step())
+      {
+        ES_Timer_InitTimer(AnimTimer, Anim_GetPeriod());
+        ReturnVal = true;
+      }
+    }
+    break;
+
+    //Plays an animation on the effect layer, round and round
+    case ES_PLAY_ANIM:
+    {
+      if (ThisEvent.EventParam < NUM_ANIMATIONS)
+      {
+        Anim_Start(Animations[ThisEvent.EventParam], CompLayerEffect, true);
+        ES_Timer_InitTimer(AnimTimer, 1);
+      }
+    }
+    break;
+
+    case ES_STOP_ANIM:
+    {
+      ES_Timer_StopTimer(AnimTimer);
+      Anim_Stop();
+      ReturnVal = true;
+    }
+    break;
+
+    //Shows the points at the right end, over the text
+    case ES_SHOW_SCORE:
+    {
+      TC_Begin(&Score, ScoreLine, sizeof(ScoreLine));
+      TC_PutUnsigned(&Score, ThisEvent.EventParam, 2);
+      TC_PutText(&Score, "pts", 0);
+      Comp_DrawString(CompLayerScore, (unsigned char *)ScoreLine,
+                      DM_AlignRight);
+      ReturnVal = true;
+    }
+    break;
+
+    case ES_HIDE_SCORE:
+    {
+      Comp_ClearLayer(CompLayerScore);
+      ReturnVal = true;
+    }
+    break;
+
+    default:
+      ;
+  }
+  // only the rows that some layer changed
+  if (ReturnVal)
+  {
+    ReturnVal = (Comp_Compose() != 0);
+  }
+  return ReturnVal;
+}
+
 /*------------------------------- Footnotes -------------------------------*/
 /*------------------------------ End of file ------------------------------*/
 
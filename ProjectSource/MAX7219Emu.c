@@ -0,0 +1,672 @@
+/****************************************************************************
+ Module
+   MAX7219Emu.c
+
+ Revision
+   1.0.0
+
+ Description
+   Host only emulation of the MAX7219 chain, see MAX7219Emu.h.
+
+ Notes
+   Chain[0] is the shift register of the controller nearest the PIC32, so
+   after a latch of MAXEMU_MODULES words Chain[MAXEMU_MODULES - 1 - m] holds
+   the word for module m. On power up the controllers are in shutdown with
+   the other registers 0, as the data sheet allows.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 23:55 mp      first pass
+****************************************************************************/
+#ifdef HOST_TEST
+/*----------------------------- Include Files -----------------------------*/
+#include <string.h>
+#include "MAX7219Emu.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define REG_NOOP          0x0
+#define REG_DIGIT_0       0x1
+#define REG_DIGIT_7       0x8
+#define REG_DECODE_MODE   0x9
+#define REG_INTENSITY     0xA
+#define REG_SCAN_LIMIT    0xB
+#define REG_SHUTDOWN      0xC
+#define REG_DISPLAY_TEST  0xF
+
+#define SEG_DP            0x80
+
+/*---------------------------- Module Functions ---------------------------*/
+static void Execute(MaxEmu_Device_t *pDevice, uint16_t Word);
+static uint8_t Segments(const MaxEmu_Device_t *pDevice, uint8_t Digit);
+
+/*---------------------------- Module Variables ---------------------------*/
+// Code B font, segments DP A B C D E F G from bit 7 down, for 0-9 - E H L P
+// and blank
+static const uint8_t CodeB[16] =
+{
+  0x7E, 0x30, 0x6D, 0x79, 0x33, 0x5B, 0x5F, 0x70,
+  0x7F, 0x7B, 0x01, 0x4F, 0x37, 0x0E, 0x67, 0x00
+};
+
+static MaxEmu_Device_t Devices[MAXEMU_MODULES];
+static uint16_t Chain[MAXEMU_MODULES];
+static MaxEmu_Stats_t Stats;
+static uint32_t WordsInLatch;
+static uint32_t FrameStartWords;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   MaxEmu_Init
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   Powers the chain up: every controller in shutdown, the registers and
+   shift registers 0 and the counts cleared.
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+void MaxEmu_Init(void)
+{
+  uint8_t Module;
+
+  memset(Devices, 0, sizeof(Devices));
+  memset(Chain, 0, sizeof(Chain));
+  memset(&Stats, 0, sizeof(Stats));
+  for (Module = 0; Module < MAXEMU_MODULES; Module++)
+  {
+    Devices[Module].Shutdown = true;
+  }
+  WordsInLatch = 0;
+  FrameStartWords = 0;
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_ShiftWord
+
+ Parameters
+   uint16_t Word : the word clocked in to the nearest controller
+
+ Returns
+   nothing
+
+ Description
+   Shifts the word into the chain, each controller passing its word on to
+   the next. Nothing changes in the registers until MaxEmu_Latch.
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+void MaxEmu_ShiftWord(uint16_t Word)
+{
+  memmove(&Chain[1], &Chain[0], (MAXEMU_MODULES - 1) * sizeof(Chain[0]));
+  Chain[0] = Word;
+  WordsInLatch++;
+  Stats.Words++;
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_Latch
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   LOAD (SS) has risen: every controller carries out the word in its shift
+   register. A latch of other than one word per controller still latches,
+   as the real chain would, but is counted as misframed.
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+void MaxEmu_Latch(void)
+{
+  uint8_t Module;
+
+  if (WordsInLatch != MAXEMU_MODULES)
+  {
+    Stats.Misframed++;
+  }
+  for (Module = 0; Module < MAXEMU_MODULES; Module++)
+  {
+    Execute(&Devices[Module], Chain[MAXEMU_MODULES - 1 - Module]);
+  }
+  WordsInLatch = 0;
+  Stats.Latches++;
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_EndFrame
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   Ends a frame, counting the words since the last one.
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+void MaxEmu_EndFrame(void)
+{
+  Stats.LastFrameWords = Stats.Words - FrameStartWords;
+  if (Stats.LastFrameWords > Stats.MaxFrameWords)
+  {
+    Stats.MaxFrameWords = Stats.LastFrameWords;
+  }
+  FrameStartWords = Stats.Words;
+  Stats.Frames++;
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_GetDevice
+
+ Parameters
+   uint8_t Module : the module, 0 at the right end
+
+ Returns
+   const MaxEmu_Device_t * : its registers, NULL past the end of the chain
+
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+const MaxEmu_Device_t *MaxEmu_GetDevice(uint8_t Module)
+{
+  return (Module < MAXEMU_MODULES) ? &Devices[Module] : NULL;
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_GetPixel
+
+ Parameters
+   uint8_t Row : 0 at the top
+   uint16_t Col : 0 at the left
+
+ Returns
+   bool : true if that LED is lit
+
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+bool MaxEmu_GetPixel(uint8_t Row, uint16_t Col)
+{
+  const MaxEmu_Device_t *pDevice;
+
+  if ((Row >= MAXEMU_ROWS) || (Col >= MAXEMU_COLS))
+  {
+    return false;
+  }
+  pDevice = &Devices[MAXEMU_MODULES - 1 - Col / 8];
+  return (Segments(pDevice, MAXEMU_ROWS - 1 - Row) >> (Col % 8)) & 1;
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_MatchesImage
+
+ Parameters
+   const char * const *pRows : MAXEMU_ROWS strings of MAXEMU_COLS characters,
+   '#' for a lit LED and anything else for a dark one
+
+ Returns
+   bool : true if the display shows exactly that
+
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+bool MaxEmu_MatchesImage(const char * const *pRows)
+{
+  uint8_t Row;
+  uint16_t Col;
+
+  for (Row = 0; Row < MAXEMU_ROWS; Row++)
+  {
+    if (strlen(pRows[Row]) != MAXEMU_COLS)
+    {
+      return false;
+    }
+    for (Col = 0; Col < MAXEMU_COLS; Col++)
+    {
+      if (MaxEmu_GetPixel(Row, Col) != (pRows[Row][Col] == '#'))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_GetStats
+
+ Parameters
+   MaxEmu_Stats_t *pStats : filled in with the counts so far
+
+ Returns
+   nothing
+
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+void MaxEmu_GetStats(MaxEmu_Stats_t *pStats)
+{
+  *pStats = Stats;
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_PrintImage
+
+ Parameters
+   FILE *pOut : where to print it
+
+ Returns
+   nothing
+
+ Description
+   Prints the display as rows of '#' and '.', in the form
+   MaxEmu_MatchesImage takes, between lines marking the modules.
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+void MaxEmu_PrintImage(FILE *pOut)
+{
+  uint8_t Row;
+  uint16_t Col;
+
+  for (Col = 0; Col < MAXEMU_COLS; Col++)
+  {
+    fputc((Col % 8 == 0) ? '+' : '-', pOut);
+  }
+  fputc('\n', pOut);
+  for (Row = 0; Row < MAXEMU_ROWS; Row++)
+  {
+    for (Col = 0; Col < MAXEMU_COLS; Col++)
+    {
+      fputc(MaxEmu_GetPixel(Row, Col) ? '#' : '.', pOut);
+    }
+    fputc('\n', pOut);
+  }
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_PrintStats
+
+ Parameters
+   FILE *pOut : where to print them
+   uint32_t BitTime_ns : the SPI bit time
+
+ Returns
+   nothing
+
+ Description
+   Prints the word, latch and frame counts, and the frame rates the SPI
+   could carry at that bit time for the average and the largest frame,
+   leaving out the gaps between latches.
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+void MaxEmu_PrintStats(FILE *pOut, uint32_t BitTime_ns)
+{
+  double WordTime = 16.0 * BitTime_ns * 1e-9;
+  double AvgWords = Stats.Frames ? (double)Stats.Words / Stats.Frames : 0;
+
+  fprintf(pOut, "%u words in %u latches (%u misframed), %u frames\n",
+          (unsigned)Stats.Words, (unsigned)Stats.Latches,
+          (unsigned)Stats.Misframed, (unsigned)Stats.Frames);
+  if ((Stats.Frames != 0) && (AvgWords > 0))
+  {
+    fprintf(pOut, "%.1f words per frame, %u at most: %.0f frames/s average, "
+            "%.0f worst case at %u ns per bit\n", AvgWords,
+            (unsigned)Stats.MaxFrameWords, 1 / (AvgWords * WordTime),
+            1 / (Stats.MaxFrameWords * WordTime), (unsigned)BitTime_ns);
+  }
+}
+
+/****************************************************************************
+ Function
+   MaxEmu_WritePPM
+
+ Parameters
+   const char *pFileName : the file to write
+   uint8_t Scale : pixels each side for each LED, at least 1
+
+ Returns
+   bool : false if the file could not be written
+
+ Description
+   Writes the display as a binary PPM, lit LEDs red with the brightness
+   set by each module's intensity, dark ones grey. From a Scale of 4 up
+   the LEDs have a dark border between them.
+ Author
+   M. Peraza, 10/18/26 23:55
+****************************************************************************/
+bool MaxEmu_WritePPM(const char *pFileName, uint8_t Scale)
+{
+  static const uint8_t Dark[3] = { 40, 40, 40 };
+  static const uint8_t Border[3] = { 0, 0, 0 };
+  uint8_t Lit[3] = { 0, 0, 0 };
+  const uint8_t *pColour;
+  FILE *pFile;
+  uint16_t x;
+  uint16_t y;
+  uint16_t Col;
+  uint8_t Row;
+  bool Edge;
+
+  if (Scale == 0)
+  {
+    Scale = 1;
+  }
+  pFile = fopen(pFileName, "wb");
+  if (pFile == NULL)
+  {
+    return false;
+  }
+  fprintf(pFile, "P6\n%u %u\n255\n", (unsigned)(MAXEMU_COLS * Scale),
+          (unsigned)(MAXEMU_ROWS * Scale));
+  for (y = 0; y < MAXEMU_ROWS * Scale; y++)
+  {
+    Row = y / Scale;
+    for (x = 0; x < MAXEMU_COLS * Scale; x++)
+    {
+      Col = x / Scale;
+      Edge = (Scale >= 4) && ((x % Scale == 0) || (y % Scale == 0));
+      if (Edge)
+      {
+        pColour = Border;
+      }
+      else if (MaxEmu_GetPixel(Row, Col))
+      {
+        Lit[0] = 95 + 10 *
+                 Devices[MAXEMU_MODULES - 1 - Col / 8].Intensity;
+        pColour = Lit;
+      }
+      else
+      {
+        pColour = Dark;
+      }
+      fwrite(pColour, 1, 3, pFile);
+    }
+  }
+  return fclose(pFile) == 0;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+// carries out a register write, as one controller does on a latch
+static void Execute(MaxEmu_Device_t *pDevice, uint16_t Word)
+{
+  uint8_t Register = (Word >> 8) & 0x0F;
+  uint8_t Data = (uint8_t)Word;
+
+  switch (Register)
+  {
+    case REG_NOOP:
+      break;
+    case REG_DECODE_MODE:
+      pDevice->DecodeMode = Data;
+      break;
+    case REG_INTENSITY:
+      pDevice->Intensity = Data & 0x0F;
+      break;
+    case REG_SCAN_LIMIT:
+      pDevice->ScanLimit = Data & 0x07;
+      break;
+    case REG_SHUTDOWN:
+      pDevice->Shutdown = (Data & 0x01) == 0;
+      break;
+    case REG_DISPLAY_TEST:
+      pDevice->DisplayTest = (Data & 0x01) != 0;
+      break;
+    default:
+      if ((Register >= REG_DIGIT_0) && (Register <= REG_DIGIT_7))
+      {
+        pDevice->Digits[Register - REG_DIGIT_0] = Data;
+      }
+      break;   // 0xD and 0xE do nothing
+  }
+}
+
+// the segments lit for a digit (0->7), after display test, shutdown, the
+// scan limit and decoding
+static uint8_t Segments(const MaxEmu_Device_t *pDevice, uint8_t Digit)
+{
+  uint8_t Data = pDevice->Digits[Digit];
+
+  if (pDevice->DisplayTest)
+  {
+    return 0xFF;
+  }
+  if (pDevice->Shutdown || (Digit > pDevice->ScanLimit))
+  {
+    return 0;
+  }
+  if (pDevice->DecodeMode & (1u << Digit))
+  {
+    return CodeB[Data & 0x0F] | (Data & SEG_DP);
+  }
+  return Data;
+}
+
+/***************************************************************************
+ module test harness, runs the display driver into the emulated chain and
+ checks the images it shows against golden images, and prints the words
+ per frame. Give it a directory to also write the images there as PPMs
+ gcc -c -IFrameworkHeaders FrameworkSource/spsc_ring.c
+ gcc -O2 -DHOST_TEST -c -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/DM_DisplayStarter.c ProjectSource/DisplayTx.c \
+     ProjectSource/FontStuff.c ProjectSource/FontGlyphs.c
+ gcc -O2 -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/MAX7219Emu.c DM_DisplayStarter.o DisplayTx.o FontStuff.o \
+     FontGlyphs.o spsc_ring.o -o max7219_test
+ The golden images are for the default chain of 8 modules; other lengths
+ are checked against the display buffer only
+ ***************************************************************************/
+#if defined(TEST)
+#include "DM_Display.h"
+
+// LEDService's SPI bit time
+#define BIT_TIME_NS 10000u
+
+static const char *PPMDir;
+
+void DisplayTx_SimWrite(uint16_t Word)
+{
+  MaxEmu_ShiftWord(Word);
+}
+
+// lets the SPI finish, raising SS after each latch, and ends the frame
+static void RunTransmitter(void)
+{
+  uint8_t TopUps;
+
+  while (DisplayTx_IsBusy())
+  {
+    // a long chain is topped up from the transmit interrupt
+    for (TopUps = 0; TopUps < MAXEMU_MODULES; TopUps++)
+    {
+      DisplayTx_SimTxInt();
+    }
+    MaxEmu_Latch();
+    DisplayTx_SimSSRise();
+  }
+  DisplayTx_CheckDone();
+  MaxEmu_EndFrame();
+}
+
+static void ShowFrame(void)
+{
+  DM_CommitFrame();
+  DM_StartDisplayUpdate();
+  RunTransmitter();
+}
+
+// the emulated display against the display buffer, pixel for pixel
+static bool MatchesBuffer(void)
+{
+  uint32_t Row[DM_ROW_WORDS];
+  uint8_t WhichRow;
+  uint16_t Col;
+  uint16_t Bit;
+
+  for (WhichRow = 0; WhichRow < MAXEMU_ROWS; WhichRow++)
+  {
+    DM_QueryRowData(WhichRow, Row);
+    for (Col = 0; Col < MAXEMU_COLS; Col++)
+    {
+      Bit = MAXEMU_COLS - 1 - Col;
+      if (MaxEmu_GetPixel(WhichRow, Col) != ((Row[Bit / 32] >> (Bit % 32)) & 1))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// checks what is shown, against the golden image if there is one for this
+// chain length, and writes it out as a PPM
+static bool CheckImage(const char *pName, const char * const *pGolden)
+{
+  MaxEmu_Stats_t FrameStats;
+  char FileName[256];
+  bool Passed = MatchesBuffer();
+
+#if MAXEMU_MODULES == 8
+  if (pGolden != NULL)
+  {
+    Passed &= MaxEmu_MatchesImage(pGolden);
+  }
+#endif
+  MaxEmu_GetStats(&FrameStats);
+  fprintf(stdout, "%-14s %3u words %s\n", pName,
+          (unsigned)FrameStats.LastFrameWords, Passed ? "ok" : "FAILED");
+  if (!Passed)
+  {
+    MaxEmu_PrintImage(stdout);
+  }
+  if (PPMDir != NULL)
+  {
+    snprintf(FileName, sizeof(FileName), "%s/%s.ppm", PPMDir, pName);
+    Passed &= MaxEmu_WritePPM(FileName, 8);
+  }
+  return Passed;
+}
+
+int main(int argc, char *argv[])
+{
+  static const char * const Blank[MAXEMU_ROWS] =
+  {
+    "................................................................",
+    "................................................................",
+    "................................................................",
+    "................................................................",
+    "................................................................",
+    "................................................................",
+    "................................................................",
+    "................................................................",
+  };
+  static const char * const GameOver[MAXEMU_ROWS] =
+  {
+    ".##..##.#.#..##..#..#.#..##..##..............#...##.....#.......",
+    "#...#.#.###.#...#.#.#.#.#...#.#.............##..#.#.##..##...##.",
+    "#.#.###.#.#.###.#.#.#.#.###.##...............#..#.#.#.#.#...##..",
+    "#.#.#.#.#.#.#...#.#.#.#.#...#.#..............#..#.#.#.#.#.....#.",
+    ".##.#.#.#.#.###..#...#..###.#.#.............###.##..##...##.##..",
+    "....................................................#...........",
+    "................................................................",
+    "................................................................",
+  };
+  static const char * const Touch[MAXEMU_ROWS] =
+  {
+    "............................................###.............#...",
+    ".............................................#...#..#.#..##.#...",
+    ".............................................#..#.#.#.#.#...##..",
+    ".............................................#..#.#.#.#.#...#.#.",
+    ".............................................#...#...##..##.#.#.",
+    "................................................................",
+    "................................................................",
+    "................................................................",
+  };
+  static const char * const TouchScrolled[MAXEMU_ROWS] =
+  {
+    "......................................###.............#.........",
+    ".......................................#...#..#.#..##.#.........",
+    ".......................................#..#.#.#.#.#...##........",
+    ".......................................#..#.#.#.#.#...#.#.......",
+    ".......................................#...#...##..##.#.#.......",
+    "................................................................",
+    "................................................................",
+    "................................................................",
+  };
+  const MaxEmu_Device_t *pDevice;
+  MaxEmu_Stats_t RunStats;
+  uint8_t Module;
+  uint8_t Step;
+  bool Passed = true;
+
+  PPMDir = (argc > 1) ? argv[1] : NULL;
+  MaxEmu_Init();
+  DisplayTx_Init();
+
+  // the whole chain comes out of shutdown, scanning 8 raw digits
+  DM_StartInitDisplay();
+  RunTransmitter();
+  for (Module = 0; Module < MAXEMU_MODULES; Module++)
+  {
+    pDevice = MaxEmu_GetDevice(Module);
+    Passed &= !pDevice->Shutdown && !pDevice->DisplayTest &&
+              (pDevice->ScanLimit == 7) && (pDevice->DecodeMode == 0) &&
+              (pDevice->Intensity == 0);
+  }
+  Passed &= CheckImage("init", Blank);
+
+  DM_AddString2Display((unsigned char *)"GAMEOVER   10pts");
+  ShowFrame();
+  Passed &= CheckImage("gameover", GameOver);
+
+  DM_ClearDisplayBuffer();
+  DM_AddString2Display((unsigned char *)"Touch");
+  ShowFrame();
+  Passed &= CheckImage("touch", Touch);
+
+  // a column at a time, each frame the last one moved left
+  for (Step = 0; Step < 6; Step++)
+  {
+    DM_ScrollDisplayBuffer(1);
+    ShowFrame();
+    Passed &= MatchesBuffer();
+  }
+  Passed &= CheckImage("touch_scrolled", TouchScrolled);
+
+  DM_ClearDisplayBuffer();
+  ShowFrame();
+  Passed &= CheckImage("cleared", Blank);
+
+  MaxEmu_GetStats(&RunStats);
+  Passed &= (RunStats.Misframed == 0);
+  MaxEmu_PrintStats(stdout, BIT_TIME_NS);
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST
+#endif // HOST_TEST
+/*------------------------------ End of file ------------------------------*/
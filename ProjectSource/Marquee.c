@@ -0,0 +1,367 @@
+/****************************************************************************
+ Module
+   Marquee.c
+
+ Revision
+   1.0.0
+
+ Description
+   Draws a message into a canvas wider than the display and copies a window
+   of it to the text layer of the compositor, one column further along for
+   each step.
+
+ Notes
+   A canvas row is a multi-word number laid out like a display row, word 0
+   least significant and the left end in the most significant bit used.
+   Canvas column c (0 at the left) is bit UsedCols - 1 - c, so the window
+   starting at column Position is the row shifted right by
+   UsedCols - DISPLAY_COLS - Position.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      the harness uses Seconds from host_test.h
+ 10/19/26 00:35 mp      added Marquee_SetColumnMs and Marquee_GetColumnMs
+ 10/18/26 23:50 mp      steps draw on the compositor's text layer
+ 10/18/26 23:40 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <string.h>
+#include "DM_Display.h"
+#include "FontStuff.h"
+#include "Marquee.h"
+#include "Compositor.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define NUM_ROWS      8
+#define CHAR_WIDTH    4
+#define DISPLAY_COLS  (DM_NUM_MODULES * 8)
+// the longest message and a display width of blank columns each side
+#define CANVAS_COLS   (MARQUEE_MAX_CHARS * CHAR_WIDTH + 2 * DISPLAY_COLS)
+#define CANVAS_WORDS  ((CANVAS_COLS + 31) / 32)
+
+/*---------------------------- Module Functions ---------------------------*/
+static void CopyWindow(const uint32_t *pCanvasRow, uint16_t Shift,
+                       uint32_t *pWindow);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t Canvas[NUM_ROWS][CANVAS_WORDS];
+static unsigned char Message[MARQUEE_MAX_CHARS + 1];
+// columns of the canvas in use for this message
+static uint16_t UsedCols;
+// left end of the window, in canvas columns
+static uint16_t Position;
+static bool Running;
+// time for each column, in ms
+static uint16_t ColumnMs = MARQUEE_COLUMN_MS;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   Marquee_Start
+
+ Parameters
+   const unsigned char *pMessage : the message to scroll
+
+ Returns
+   bool : false if that message is already scrolling, which is left alone
+
+ Description
+   Draws the message into the canvas and puts the window at the start, with
+   the message just off the right end. The next Marquee_Step shows it.
+ Author
+   M. Peraza, 10/18/26 23:40
+****************************************************************************/
+bool Marquee_Start(const unsigned char *pMessage)
+{
+  const uint8_t *pGlyph;
+  uint16_t Bit;
+  uint8_t Length;
+  uint8_t WhichRow;
+  uint8_t i;
+
+  if (Running && (strncmp((const char *)Message, (const char *)pMessage,
+                          MARQUEE_MAX_CHARS) == 0))
+  {
+    return false;
+  }
+  strncpy((char *)Message, (const char *)pMessage, MARQUEE_MAX_CHARS);
+  Message[MARQUEE_MAX_CHARS] = '\0';
+  Length = strlen((const char *)Message);
+
+  memset(Canvas, 0, sizeof(Canvas));
+  UsedCols = Length * CHAR_WIDTH + 2 * DISPLAY_COLS;
+  for (i = 0; i < Length; i++)
+  {
+    // low bit of the glyph's nibble, glyphs never straddle words
+    Bit = UsedCols - DISPLAY_COLS - (i + 1) * CHAR_WIDTH;
+    pGlyph = getFontGlyph(Message[i]);
+    for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+    {
+      Canvas[WhichRow][Bit / 32] |= (uint32_t)pGlyph[WhichRow] << (Bit % 32);
+    }
+  }
+  Position = 0;
+  Running = true;
+  return true;
+}
+
+/****************************************************************************
+ Function
+   Marquee_Step
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   Copies the window onto the text layer and moves it 1 column on, back to
+   the start after the message has gone off the left end. The caller
+   composes and commits the frame.
+ Author
+   M. Peraza, 10/18/26 23:40
+****************************************************************************/
+void Marquee_Step(void)
+{
+  uint32_t Window[DM_ROW_WORDS];
+  uint8_t WhichRow;
+
+  if (!Running)
+  {
+    return;
+  }
+  for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+  {
+    CopyWindow(Canvas[WhichRow], UsedCols - DISPLAY_COLS - Position, Window);
+    Comp_PutLayerRow(CompLayerText, Window, WhichRow);
+  }
+  // the last window is all blank, and so is the first
+  if (++Position == UsedCols - DISPLAY_COLS)
+  {
+    Position = 0;
+  }
+}
+
+/****************************************************************************
+ Function
+   Marquee_Stop
+
+ Parameters
+   None
+
+ Returns
+   nothing
+
+ Description
+   Stops stepping; the text layer keeps the last window.
+ Author
+   M. Peraza, 10/18/26 23:40
+****************************************************************************/
+void Marquee_Stop(void)
+{
+  Running = false;
+}
+
+/****************************************************************************
+ Function
+   Marquee_IsRunning
+
+ Parameters
+   None
+
+ Returns
+   bool : true between Marquee_Start and Marquee_Stop
+
+ Author
+   M. Peraza, 10/18/26 23:40
+****************************************************************************/
+bool Marquee_IsRunning(void)
+{
+  return Running;
+}
+
+/****************************************************************************
+ Function
+   Marquee_SetColumnMs
+
+ Parameters
+   uint16_t Ms : time for each column, 0 for MARQUEE_COLUMN_MS
+
+ Returns
+   nothing
+
+ Description
+   Sets the scrolling speed. A message that is already scrolling changes
+   speed from its next column.
+ Author
+   M. Peraza, 10/19/26 00:35
+****************************************************************************/
+void Marquee_SetColumnMs(uint16_t Ms)
+{
+  ColumnMs = (Ms != 0) ? Ms : MARQUEE_COLUMN_MS;
+}
+
+/****************************************************************************
+ Function
+   Marquee_GetColumnMs
+
+ Parameters
+   None
+
+ Returns
+   uint16_t : time for each column, in ms
+
+ Author
+   M. Peraza, 10/19/26 00:35
+****************************************************************************/
+uint16_t Marquee_GetColumnMs(void)
+{
+  return ColumnMs;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+// the DISPLAY_COLS bits of a canvas row starting Shift bits up
+static void CopyWindow(const uint32_t *pCanvasRow, uint16_t Shift,
+                       uint32_t *pWindow)
+{
+  uint16_t WordShift = Shift / 32;
+  uint8_t BitShift = Shift % 32;
+  uint8_t WhichWord;
+  uint32_t Word;
+
+  for (WhichWord = 0; WhichWord < DM_ROW_WORDS; WhichWord++)
+  {
+    Word = pCanvasRow[WhichWord + WordShift] >> BitShift;
+    if ((BitShift != 0) && (WhichWord + WordShift + 1 < CANVAS_WORDS))
+    {
+      Word |= pCanvasRow[WhichWord + WordShift + 1] << (32 - BitShift);
+    }
+    pWindow[WhichWord] = Word;
+  }
+#if DISPLAY_COLS % 32 != 0
+  // nothing above the display
+  pWindow[DM_ROW_WORDS - 1] &= (1u << (DISPLAY_COLS % 32)) - 1;
+#endif
+}
+
+/***************************************************************************
+ module test harness, scrolls a message through and checks every window
+ pixel for pixel, and times a step
+ gcc -c -IFrameworkHeaders FrameworkSource/spsc_ring.c
+ gcc -O2 -DHOST_TEST -c -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/DM_DisplayStarter.c ProjectSource/DisplayTx.c \
+     ProjectSource/FontStuff.c ProjectSource/FontGlyphs.c \
+     ProjectSource/Compositor.c
+ gcc -O2 -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/Marquee.c Compositor.o DM_DisplayStarter.o DisplayTx.o \
+     FontStuff.o FontGlyphs.o spsc_ring.o -o marquee_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include "host_test.h"
+
+#define BENCH_STEPS 1000000u
+
+static uint32_t WordsSent;
+
+void DisplayTx_SimWrite(uint16_t Word)
+{
+  WordsSent++;
+}
+
+// the pixel at display column x of the message drawn starting at column
+// Left, which may be off either end
+static bool Pixel(const char *pMessage, int Left, uint8_t Row, int x)
+{
+  int Col = x - Left;
+
+  if ((Col < 0) || (Col >= (int)strlen(pMessage) * CHAR_WIDTH))
+  {
+    return false;
+  }
+  return (getFontGlyph(pMessage[Col / CHAR_WIDTH])[Row] >>
+          (CHAR_WIDTH - 1 - Col % CHAR_WIDTH)) & 1;
+}
+
+int main(void)
+{
+  static const char Text[] = "Squeeze the ball as hard as you can! 12pts";
+  uint32_t Row[DM_ROW_WORDS];
+  uint32_t Steps = strlen(Text) * CHAR_WIDTH + DISPLAY_COLS;
+  uint32_t Step;
+  uint32_t RowsChanged = 0;
+  uint8_t Changed;
+  uint8_t WhichRow;
+  double Start;
+  bool Shown;
+  bool Passed = true;
+  int x;
+
+  DisplayTx_Init();
+  Comp_Init();
+  Passed &= Marquee_Start((const unsigned char *)Text);
+  Passed &= !Marquee_Start((const unsigned char *)Text);  // already going
+  // twice round, to check it starts again
+  for (Step = 0; (Step < 2 * Steps) && Passed; Step++)
+  {
+    Marquee_Step();
+    Comp_Compose();
+    Changed = DM_CommitFrame();
+    while (Changed != 0)
+    {
+      RowsChanged += Changed & 1;
+      Changed >>= 1;
+    }
+    DM_StartDisplayUpdate();
+    while (DisplayTx_IsBusy())
+    {
+      DisplayTx_SimSSRise();
+    }
+    for (WhichRow = 0; (WhichRow < NUM_ROWS) && Passed; WhichRow++)
+    {
+      DM_QueryRowData(WhichRow, Row);
+      for (x = 0; x < DISPLAY_COLS; x++)
+      {
+        Shown = (Row[(DISPLAY_COLS - 1 - x) / 32] >>
+                 ((DISPLAY_COLS - 1 - x) % 32)) & 1;
+        if (Shown != Pixel(Text, DISPLAY_COLS - (int)(Step % Steps), WhichRow,
+                           x))
+        {
+          fprintf(stdout, "failed: step %u row %u column %d\n",
+                  (unsigned)Step, WhichRow, x);
+          Passed = false;
+          break;
+        }
+      }
+    }
+  }
+  fprintf(stdout, "%u steps, %u of %u rows sent, %u words\n",
+          (unsigned)(2 * Steps), (unsigned)RowsChanged,
+          (unsigned)(2 * Steps * NUM_ROWS), (unsigned)WordsSent);
+
+  Start = Seconds();
+  for (Step = 0; Step < BENCH_STEPS; Step++)
+  {
+    Marquee_Step();
+  }
+  fprintf(stdout, "%.0f ns per step\n",
+          (Seconds() - Start) / BENCH_STEPS * 1e9);
+
+  Marquee_Stop();
+  Passed &= !Marquee_IsRunning();
+
+  // the speed, and back to the default
+  Passed &= (Marquee_GetColumnMs() == MARQUEE_COLUMN_MS);
+  Marquee_SetColumnMs(25);
+  Passed &= (Marquee_GetColumnMs() == 25);
+  Marquee_SetColumnMs(0);
+  Passed &= (Marquee_GetColumnMs() == MARQUEE_COLUMN_MS);
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+/*------------------------------ End of file ------------------------------*/
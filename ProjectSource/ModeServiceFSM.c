@@ -21,8 +21,13 @@
 #include "PWM_PIC32.h"
 #include "InstructionService.h"
 #include "VibrationFSM.h"
+#include "ES_ShortTimer.h"
 #include "terminal.h"
 #include "dbprintf.h"
+#include "dblog.h"
+#include "TextComposer.h"
+#include "GameTelemetry.h"
+#include "AnimPlayer.h"
 #include <stdlib.h>
 #include <string.h>
 /*----------------------------- Module Defines ----------------------------*/
@@ -32,6 +37,8 @@
    relevant to the behavior of this state machine
 */
 static void PlayAudio(int Audio);
+static void IdleAnimation(bool Play);
+static void ShowScore(bool Show);
 static void Light(Module_t Module);
 static void LightSingle(Module_t Module, bool ON);
 static int RandomModule(void);
@@ -45,6 +52,8 @@ static GameState_t CurrentGameState;
 //Audio Setup
 #define GameAudioPin LATAbits.LATA3
 #define ZenAudioPin LATAbits.LATA4
+//Length of the low pulse that triggers the Zen audio (us)
+#define ZenAudioPulseTime 100000
 static enum {
     GameAudio,
     ZenAudio
@@ -120,8 +129,9 @@ bool InitModeServiceFSM(uint8_t Priority)
   
   //Setup Game
   LEDEvent.EventType = ES_ADD_STRING;
-  sprintf(Instruction, "WELCOME!        ");
+  strcpy((char *)Instruction, "WELCOME!        ");
   PostLEDService(LEDEvent);
+  IdleAnimation(true);
   Points = 0;
   
   ES_Timer_InitTimer(VibrationTimer, 1000);
@@ -219,6 +229,36 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
   
   ES_Event_t VibrationEvent;
 
+  TextComposer_t Line;
+
+  //Timers that expired together arrive as one set, run each of them
+  //through the state machine as its own timeout, highest timer first
+  if (ThisEvent.EventType == ES_TIMEOUT_SET)
+  {
+      ES_Event_t TimeoutEvent;
+      uint16_t ExpiredSet = ThisEvent.EventParam;
+      TimeoutEvent.EventType = ES_TIMEOUT;
+      while (ExpiredSet != 0)
+      {
+          TimeoutEvent.EventParam = ES_Timer_NextInSet(ExpiredSet);
+          ExpiredSet &= ~(1u << TimeoutEvent.EventParam);
+          ReturnEvent = RunModeServiceFSM(TimeoutEvent);
+          if (ReturnEvent.EventType != ES_NO_EVENT)
+          {
+              break;
+          }
+      }
+      return ReturnEvent;
+  }
+
+  //End of the Zen audio trigger pulse, the same in every state
+  if ((ThisEvent.EventType == ES_SHORT_TIMEOUT) &&
+      (ThisEvent.EventParam == AudioPulseTimer))
+  {
+      ZenAudioPin = 1;
+      return ReturnEvent;
+  }
+
   switch (CurrentState)
   {
     case IdleMode:     
@@ -231,6 +271,8 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                 //Clear Instructions
                 memset(Instruction, 0, sizeof(Instruction));
                 PWMOperate_SetDutyOnChannel(0, 1);
+                IdleAnimation(false);
+                ShowScore(false);
                 
                 //Switch States and Set GameState
                 CurrentState = GameMode;
@@ -244,8 +286,10 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
             case ES_ZEN:
             {
                 //Initial Message
-                sprintf(Instruction, "Relax   Enjoy   ", Points);
+                strcpy((char *)Instruction, "Relax   Enjoy   ");
                 PostLEDService(LEDEvent);
+                IdleAnimation(false);
+                ShowScore(false);
 
                 //Switch State
                 CurrentState = ZenMode;
@@ -293,8 +337,10 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                 {
                     ES_Timer_InitTimer(VibrationTimer, 100);
                     LEDEvent.EventType = ES_ADD_STRING;
-                    sprintf(Instruction, "WELCOME!        ");
+                    strcpy((char *)Instruction, "WELCOME!        ");
                     PostLEDService(LEDEvent);
+                    IdleAnimation(true);
+                    ShowScore(false);
                 }
                 
             }
@@ -315,6 +361,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
             {
                 //Play Game Audio
                 PlayAudio(GameAudio);
+                Telemetry_GameStart();
 
                 //Start GameTimer 60s
                 ES_Timer_InitTimer(GameTimer, 60000);
@@ -331,6 +378,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
             {
                 //pick a random module 0-3
                 CurrentModule = RandomModule();
+                Telemetry_RoundStart(CurrentModule);
 
                 //Start Printing Module Instructions
                 InstructEvent.EventType = ES_INSTRUCT;
@@ -359,6 +407,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                     {
                         if (CurrentModule == Shake)
                         {
+                            Telemetry_RoundEnd(RoundHit);
                             Points++;
                             LightBlinkCount = 0;
                             GameBlinkModule = Shake;
@@ -374,6 +423,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                     {
                         if (CurrentModule == Squeeze)
                         {
+                            Telemetry_RoundEnd(RoundHit);
                             Points++;
                             LightBlinkCount = 0;
                             GameBlinkModule = Squeeze;
@@ -389,6 +439,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                     {
                         if (CurrentModule == Touch)
                         {
+                            Telemetry_RoundEnd(RoundHit);
                             Points++;
                             LightBlinkCount = 0;
                             GameBlinkModule = Touch;
@@ -404,6 +455,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                     {
                         if (CurrentModule == Wave)
                         {
+                            Telemetry_RoundEnd(RoundHit);
                             Points++;
                             LightBlinkCount = 0;
                             GameBlinkModule = Wave;
@@ -417,19 +469,18 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                     //If all sensors inactive for 30s reset and end game
                     case ES_NOTRIG:
                     {
+                        Telemetry_RoundEnd(RoundInactive);
                         //Stop Instructions
                         InstructEvent.EventType = ES_STOPINSTRUCT;
                         PostInstructionService(InstructEvent);
-                        sprintf(Instruction, "Inactive        ");
+                        strcpy((char *)Instruction, "Inactive        ");
                         PostLEDService(LEDEvent);
                         
                         ES_Timer_InitTimer(NoTriggerLightTimer, 3000);
                         ES_Timer_InitTimer(NoTrigBlinkLight, 10);
 
                         //Stop Timers
-                        ES_Timer_StopTimer(GameTimer);
-                        ES_Timer_StopTimer(ModuleTimer);
-                        ES_Timer_StopTimer(BlinkLightTimer);
+                        ES_Timer_StopGroup(MyPriority, GamePlayTimers);
                         ES_PostToService(MyPriority, ReturnEvent); 
                     }
                     break;
@@ -438,6 +489,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                     {
                         if (ThisEvent.EventParam == GameTimer)
                         {
+                            Telemetry_RoundEnd(RoundGameOver);
                             Light(No_Module);
                             CurrentGameState = EndGame;
                             ES_PostToService(MyPriority, ReturnEvent);
@@ -473,6 +525,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                         }
                         if (ThisEvent.EventParam == ModuleTimer)
                         {
+                            Telemetry_RoundEnd(RoundTimedOut);
                             CurrentGameState = ActivateModule;
                             ES_PostToService(MyPriority, ReturnEvent);
                         }
@@ -507,21 +560,18 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                 InstructEvent.EventType = ES_STOPINSTRUCT;
                 PostInstructionService(InstructEvent);
 
-                //Accounts for double digit spacing
-                if (Points >= 10)
-                {
-                    sprintf(Instruction, "GAMEOVER   %dpts", Points);
-                }
-                else
-                {
-                    sprintf(Instruction, "GAMEOVER    %dpts", Points);
-                }
+                //GAMEOVER on the left, the points on the score layer
+                TC_Begin(&Line, (char *)Instruction, sizeof(Instruction));
+                TC_PutText(&Line, "GAMEOVER", 16);
                 PostLEDService(LEDEvent);
+                ShowScore(true);
 
                 //Stop Game Audio
                 PlayAudio(GameAudio);
 
                 //Reset
+                ES_Timer_StopGroup(MyPriority, GamePlayTimers);
+                Telemetry_GameEnd(Points);
                 Points = 0;
                 CurrentState = IdleMode;
                 ES_Timer_InitTimer(IdleLightTimer, 500);
@@ -541,7 +591,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
         {
             case ES_Shake:
             {
-                sprintf(Instruction, "Nice To Meet You");
+                strcpy((char *)Instruction, "Nice To Meet You");
                 PostLEDService(LEDEvent);
                 PlayAudio(ZenAudio);
                 
@@ -554,7 +604,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
 
             case ES_Squeeze:
             {
-                sprintf(Instruction, "OUCH");
+                strcpy((char *)Instruction, "OUCH");
                 PostLEDService(LEDEvent);
                 PlayAudio(ZenAudio);
                 
@@ -567,7 +617,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
 
             case ES_Touch:
             {
-                sprintf(Instruction, "Boop");
+                strcpy((char *)Instruction, "Boop");
                 PostLEDService(LEDEvent);
                 PlayAudio(ZenAudio);
                 
@@ -580,7 +630,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
 
             case ES_Wave:
             {
-                sprintf(Instruction, "Hello");
+                strcpy((char *)Instruction, "Hello");
                 PostLEDService(LEDEvent);
                 PlayAudio(ZenAudio);
                 
@@ -597,15 +647,14 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                 //Stop Instructions
                 InstructEvent.EventType = ES_STOPINSTRUCT;
                 PostInstructionService(InstructEvent);
-                sprintf(Instruction, "Inactive        ");
+                strcpy((char *)Instruction, "Inactive        ");
                 PostLEDService(LEDEvent);
 
                 ES_Timer_InitTimer(NoTriggerLightTimer, 3000);
                 ES_Timer_InitTimer(NoTrigBlinkLight, 10);
 
                 //Reset
-                ES_Timer_StopTimer(GameTimer);
-                ES_Timer_StopTimer(IdleLightTimer);
+                ES_Timer_StopGroup(MyPriority, ZenPlayTimers);
                 ES_PostToService(MyPriority, ReturnEvent); 
             }
             break;
@@ -664,7 +713,7 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                 {
                     InstructEvent.EventType = ES_STOPINSTRUCT;
                     PostInstructionService(InstructEvent);
-                    sprintf(Instruction, "NIRVANA!        ");
+                    strcpy((char *)Instruction, "NIRVANA!        ");
                     PostLEDService(LEDEvent);
                     VibrationEvent.EventType = StopMotor;
                     PostVibrationFSM(VibrationEvent);
@@ -677,8 +726,9 @@ ES_Event_t RunModeServiceFSM(ES_Event_t ThisEvent)
                 {
                     InstructEvent.EventType = ES_STOPINSTRUCT;
                     PostInstructionService(InstructEvent);
-                    sprintf(Instruction, "WELCOME!        ");
+                    strcpy((char *)Instruction, "WELCOME!        ");
                     PostLEDService(LEDEvent);
+                    IdleAnimation(true);
                     VibrationEvent.EventType = StopMotor;
                     PostVibrationFSM(VibrationEvent);
                         
@@ -765,18 +815,70 @@ static void PlayAudio(int Audio)
 {
     if (Audio == GameAudio)
     {
-        DB_printf("FLIP %d\n", !Flip);
+        DB_LOG("FLIP %d\n", !Flip);
         Flip = !Flip;
         GameAudioPin = Flip;
     }
     if (Audio == ZenAudio)
     {
+        //Pulse low, the short timer ends the pulse
         ZenAudioPin = 0;
-        for (int i = 0; i<1000000; i++) {}
-        ZenAudioPin = 1;
+        ES_ShortTimer_Start(AudioPulseTimer, ZenAudioPulseTime);
     }
 }
 
+/****************************************************************************
+ Function
+    IdleAnimation
+
+ Parameters
+    bool, true to start the idle animation, false to stop it
+
+ Returns
+    nothing
+
+ Description
+    Has the LED service play the idle animation next to WELCOME!, or stop
+    it and clear it away
+
+ Author
+    M. Peraza, 10/18/26 23:58
+****************************************************************************/
+static void IdleAnimation(bool Play)
+{
+    ES_Event_t AnimEvent;
+
+    AnimEvent.EventType = Play ? ES_PLAY_ANIM : ES_STOP_ANIM;
+    AnimEvent.EventParam = AnimIdle;
+    PostLEDService(AnimEvent);
+}
+
+/****************************************************************************
+ Function
+    ShowScore
+
+ Parameters
+    bool, true to show the points, false to clear them away
+
+ Returns
+    nothing
+
+ Description
+    Has the LED service draw the points on its score layer, at the right
+    end of the display over whatever text is there
+
+ Author
+    M. Peraza, 10/19/26 00:25
+****************************************************************************/
+static void ShowScore(bool Show)
+{
+    ES_Event_t ScoreEvent;
+
+    ScoreEvent.EventType = Show ? ES_SHOW_SCORE : ES_HIDE_SCORE;
+    ScoreEvent.EventParam = (uint16_t)Points;
+    PostLEDService(ScoreEvent);
+}
+
 /****************************************************************************
  Function
     Light
@@ -14,6 +14,7 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 19:15 mp      banner goes through LOG_INFO, compiled out of production
  10/26/17 18:26 jec     moves definition of ALL_BITS to ES_Port.h
  10/19/17 21:28 jec     meaningless change to test updating
  10/19/17 18:42 jec     removed referennces to driverlib and programmed the
@@ -43,6 +44,9 @@
 #include "ES_Port.h"
 #include "terminal.h"
 #include "dbprintf.h"
+#define ES_LOG_CHANNEL LOG_CH_SCROLL
+#define ES_LOG_LEVEL   LOG_LEVEL_SCROLL
+#include "ES_Log.h"
 #include "LEDService.h"
 
 /*----------------------------- Module Defines ----------------------------*/
@@ -97,12 +101,11 @@ bool InitScrollService(uint8_t Priority)
 
   // When doing testing, it is useful to announce just which program
   // is running.
-  clrScrn();
-  puts("\rStarting Test Harness for \r");
-  DB_printf( "the 2nd Generation Events & Services Framework V2.4\r\n");
-  DB_printf( "compiled at %s on %s\n", __TIME__, __DATE__);
-  DB_printf( "\n\r\n");
-  DB_printf( "Press any key to post key-stroke events to Scroll Service\n\r");
+  LOG_INFO("\x1b[2J\rStarting Test Harness for \r\n");
+  LOG_INFO("the 2nd Generation Events & Services Framework V2.4\r\n");
+  LOG_INFO("compiled at %s on %s\n", __TIME__, __DATE__);
+  LOG_INFO("\n\r\n");
+  LOG_INFO("Press any key to post key-stroke events to Scroll Service\n\r");
 
   /********************************************
    in here you write your initialization code
@@ -0,0 +1,308 @@
+/****************************************************************************
+ Module
+   ShellService.c
+
+ Revision
+   1.0.0
+
+ Description
+   Introspection shell for the running framework. Press ':' to get a prompt,
+   then type a command and Enter:
+     queues      pending events in each service's queue
+     timers      running timers and the ticks they have left
+     ready       the Ready bitmap
+     states      the state of each state machine
+     stats       terminal overruns and event injection counts
+     lat [clear] post to dispatch latencies (ES_EVENT_TIMESTAMPS)
+     exit        back to keystrokes
+   Events are shown as type:param, the numbers of ES_EventType_t.
+
+ Notes
+   This is Service 0, the lowest priority, so it only runs when the game
+   services have nothing to do. Nothing is printed until a command comes in.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 21:00 mp      first pass, takes over Service 0 from the test harness
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+// This module
+#include "ShellService.h"
+
+// Event & Services Framework
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Inject.h"
+#include "terminal.h"
+#include "dbprintf.h"
+#include <string.h>
+
+// the state machines we report on
+#include "ModeServiceFSM.h"
+#include "InstructionService.h"
+#include "VibrationFSM.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SHELL_KEY ':'
+#define MAX_PEEK 8    // the most events listed for one queue
+
+/*------------------------------ Module Types -----------------------------*/
+typedef struct
+{
+  const char *pName;
+  void (*pCommand)(void);
+}ShellCommand_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void ShowHelp(void);
+static void ShowQueues(void);
+static void ShowTimers(void);
+static void ShowReady(void);
+static void ShowStates(void);
+static void ShowStats(void);
+#ifdef ES_EVENT_TIMESTAMPS
+static void ShowLatency(void);
+static void ClearLatency(void);
+#endif
+static void LeaveShell(void);
+static const char *StateName(const char * const *pNames, uint8_t NumNames,
+    uint8_t State);
+
+/*---------------------------- Module Variables ---------------------------*/
+// with the introduction of Gen2, we need a module level Priority variable
+static uint8_t MyPriority;
+
+static const ShellCommand_t Commands[] =
+{
+  { "help", ShowHelp },
+  { "queues", ShowQueues },
+  { "timers", ShowTimers },
+  { "ready", ShowReady },
+  { "states", ShowStates },
+  { "stats", ShowStats },
+#ifdef ES_EVENT_TIMESTAMPS
+  { "lat", ShowLatency },
+  { "lat clear", ClearLatency },
+#endif
+  { "exit", LeaveShell },
+};
+
+// in the order of the state enums in the headers
+static const char * const ModeNames[] = { "Idle", "Game", "Zen" };
+static const char * const InstructionNames[] =
+{
+  "WaitForGameStart", "StartInstructions"
+};
+static const char * const VibrationNames[] = { "Init", "On", "Off" };
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     InitShellService
+
+ Parameters
+     uint8_t : the priorty of this service
+
+ Returns
+     bool, false if error in initialization, true otherwise
+
+ Description
+     Saves away the priority and posts the initial transition event
+ Author
+     M. Peraza, 10/18/26 21:00
+****************************************************************************/
+bool InitShellService(uint8_t Priority)
+{
+  ES_Event_t ThisEvent;
+
+  MyPriority = Priority;
+
+  ThisEvent.EventType = ES_INIT;
+  return ES_PostToService(MyPriority, ThisEvent);
+}
+
+/****************************************************************************
+ Function
+     PostShellService
+
+ Parameters
+     ES_Event ThisEvent ,the event to post to the queue
+
+ Returns
+     bool false if the Enqueue operation failed, true otherwise
+
+ Description
+     Posts an event to this service's queue
+ Author
+     M. Peraza, 10/18/26 21:00
+****************************************************************************/
+bool PostShellService(ES_Event_t ThisEvent)
+{
+  return ES_PostToService(MyPriority, ThisEvent);
+}
+
+/****************************************************************************
+ Function
+    RunShellService
+
+ Parameters
+   ES_Event : the event to process
+
+ Returns
+   ES_Event, ES_NO_EVENT if no error ES_ERROR otherwise
+
+ Description
+   ':' opens the shell by switching the terminal to line mode; each line
+   after that is looked up in Commands and run
+ Author
+   M. Peraza, 10/18/26 21:00
+****************************************************************************/
+ES_Event_t RunShellService(ES_Event_t ThisEvent)
+{
+  ES_Event_t  ReturnEvent;
+  const char  *pLine;
+  uint8_t     i;
+
+  ReturnEvent.EventType = ES_NO_EVENT; // assume no errors
+
+  switch (ThisEvent.EventType)
+  {
+    case ES_NEW_KEY:
+    {
+      if (SHELL_KEY == ThisEvent.EventParam)
+      {
+        Terminal_SetLineMode(true);
+        DB_printf("\r\nshell, 'help' for commands\r\n> ");
+      }
+    }
+    break;
+
+    case ES_NEW_LINE:
+    {
+      pLine = Terminal_GetLine(ThisEvent.EventParam);
+      for (i = 0; i < ARRAY_SIZE(Commands); i++)
+      {
+        if (0 == strcmp(pLine, Commands[i].pName))
+        {
+          Commands[i].pCommand();
+          break;
+        }
+      }
+      if ((i == ARRAY_SIZE(Commands)) && (pLine[0] != '\0'))
+      {
+        DB_printf("unknown command %s\r\n", pLine);
+      }
+      if (Terminal_IsLineMode())
+      {
+        DB_printf("> ");
+      }
+    }
+    break;
+
+    default:
+    {}
+    break;
+  }
+
+  return ReturnEvent;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+static void ShowHelp(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < ARRAY_SIZE(Commands); i++)
+  {
+    DB_printf("%s\r\n", Commands[i].pName);
+  }
+}
+
+// one line per service: depth/size then the queued events, oldest first
+static void ShowQueues(void)
+{
+  ES_Event_t  Pending[MAX_PEEK];
+  uint8_t     NumPending;
+  uint8_t     QueueSize;
+  uint8_t     Service;
+  uint8_t     i;
+
+  for (Service = 0; Service < NUM_SERVICES; Service++)
+  {
+    NumPending = ES_PeekServiceQueue(Service, Pending, MAX_PEEK, &QueueSize);
+    DB_printf("Svc %d %d/%d", Service, NumPending, QueueSize);
+    for (i = 0; (i < NumPending) && (i < MAX_PEEK); i++)
+    {
+      DB_printf(" %d:%d", Pending[i].EventType, Pending[i].EventParam);
+    }
+    DB_printf("%s\r\n", (NumPending > MAX_PEEK) ? " ..." : "");
+  }
+}
+
+static void ShowTimers(void)
+{
+  uint16_t  Active = ES_Timer_GetActive();
+  uint8_t   Timer;
+
+  if (Active == 0)
+  {
+    DB_printf("no timers running\r\n");
+  }
+  while (Active != 0)
+  {
+    Timer = ES_Timer_NextInSet(Active);
+    Active &= ~(1u << Timer);
+    DB_printf("Timer %d %u ticks\r\n", Timer, ES_Timer_GetRemaining(Timer));
+  }
+}
+
+static void ShowReady(void)
+{
+  DB_printf("Ready 0x%x\r\n", ES_GetReady());
+}
+
+static void ShowStates(void)
+{
+  DB_printf("Mode %s\r\n", StateName(ModeNames, ARRAY_SIZE(ModeNames),
+      QueryModeServiceFSM()));
+  DB_printf("Instruction %s\r\n", StateName(InstructionNames,
+      ARRAY_SIZE(InstructionNames), QueryInstructionService()));
+  DB_printf("Vibration %s\r\n", StateName(VibrationNames,
+      ARRAY_SIZE(VibrationNames), QueryVibrationFSM()));
+}
+
+static void ShowStats(void)
+{
+  DB_printf("Terminal overruns tx %u rx %u\r\n", Terminal_GetTxOverruns(),
+      Terminal_GetRxOverruns());
+  DB_printf("Injected frames %u errors %u\r\n", ES_Inject_GetFrameCount(),
+      ES_Inject_GetErrorCount());
+}
+
+#ifdef ES_EVENT_TIMESTAMPS
+static void ShowLatency(void)
+{
+  ES_PrintLatencyStats();
+}
+
+static void ClearLatency(void)
+{
+  ES_ClearLatencyStats();
+}
+#endif
+
+static void LeaveShell(void)
+{
+  Terminal_SetLineMode(false);
+}
+
+static const char *StateName(const char * const *pNames, uint8_t NumNames,
+    uint8_t State)
+{
+  return (State < NumNames) ? pNames[State] : "?";
+}
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,310 @@
+/****************************************************************************
+ Module
+   TextComposer.c
+
+ Revision
+   1.0.0
+
+ Description
+   Fixed-field line composer for the display strings, see TextComposer.h.
+
+ Notes
+   Integers are converted by repeated division into a scratch buffer,
+   least significant digit first, then copied out behind the padding.
+   There is no varargs parsing and nothing from the C library.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:40 mp      the harness uses Check and Seconds from host_test.h
+ 10/18/26 21:20 mp      first pass
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "TextComposer.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_DIGITS 10   // 4294967295
+
+/*---------------------------- Module Functions ---------------------------*/
+static void PutChar(TextComposer_t *pTC, char NewChar);
+static void PutDigits(TextComposer_t *pTC, uint32_t Value, bool Negative,
+    uint8_t Width);
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   TC_Begin
+
+ Parameters
+   TextComposer_t *pTC : the composer to set up
+   char *pLine : the line buffer to write into
+   uint8_t Size : size of the line buffer, including room for the NUL
+
+ Returns
+   nothing
+
+ Description
+   Starts a new, empty line in pLine.
+ Author
+   M. Peraza, 10/18/26 21:20
+****************************************************************************/
+void TC_Begin(TextComposer_t *pTC, char *pLine, uint8_t Size)
+{
+  pTC->pLine = pLine;
+  pTC->Size = Size;
+  pTC->Length = 0;
+  if (Size > 0)
+  {
+    pLine[0] = '\0';
+  }
+}
+
+/****************************************************************************
+ Function
+   TC_PutText
+
+ Parameters
+   TextComposer_t *pTC : the line being built
+   const char *pText : the text to add
+   uint8_t Width : the field width, 0 for just the text
+
+ Returns
+   nothing
+
+ Description
+   Adds the text left aligned, padded with spaces out to Width.
+ Author
+   M. Peraza, 10/18/26 21:20
+****************************************************************************/
+void TC_PutText(TextComposer_t *pTC, const char *pText, uint8_t Width)
+{
+  uint8_t Written = 0;
+
+  while (*pText != '\0')
+  {
+    PutChar(pTC, *pText++);
+    Written++;
+  }
+  while (Written++ < Width)
+  {
+    PutChar(pTC, ' ');
+  }
+}
+
+/****************************************************************************
+ Function
+   TC_PutUnsigned
+
+ Parameters
+   TextComposer_t *pTC : the line being built
+   uint32_t Value : the number to add
+   uint8_t Width : the field width, 0 for just the digits
+
+ Returns
+   nothing
+
+ Description
+   Adds the number in decimal, right aligned in Width.
+ Author
+   M. Peraza, 10/18/26 21:20
+****************************************************************************/
+void TC_PutUnsigned(TextComposer_t *pTC, uint32_t Value, uint8_t Width)
+{
+  PutDigits(pTC, Value, false, Width);
+}
+
+/****************************************************************************
+ Function
+   TC_PutInt
+
+ Parameters
+   TextComposer_t *pTC : the line being built
+   int32_t Value : the number to add
+   uint8_t Width : the field width, 0 for just the digits
+
+ Returns
+   nothing
+
+ Description
+   Adds the number in decimal, right aligned in Width, the sign counting
+   towards the width.
+ Author
+   M. Peraza, 10/18/26 21:20
+****************************************************************************/
+void TC_PutInt(TextComposer_t *pTC, int32_t Value, uint8_t Width)
+{
+  if (Value < 0)
+  {
+    // negate as unsigned so that INT32_MIN comes out right
+    PutDigits(pTC, 0u - (uint32_t)Value, true, Width);
+  }
+  else
+  {
+    PutDigits(pTC, (uint32_t)Value, false, Width);
+  }
+}
+
+/****************************************************************************
+ Function
+   TC_End
+
+ Parameters
+   TextComposer_t *pTC : the line being built
+
+ Returns
+   uint8_t : the length of the finished line
+
+ Description
+   Finishes the line. The line is already terminated, this is for the length.
+ Author
+   M. Peraza, 10/18/26 21:20
+****************************************************************************/
+uint8_t TC_End(TextComposer_t *pTC)
+{
+  return pTC->Length;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+static void PutChar(TextComposer_t *pTC, char NewChar)
+{
+  if ((pTC->Length + 1) < pTC->Size)
+  {
+    pTC->pLine[pTC->Length++] = NewChar;
+    pTC->pLine[pTC->Length] = '\0';
+  }
+}
+
+static void PutDigits(TextComposer_t *pTC, uint32_t Value, bool Negative,
+    uint8_t Width)
+{
+  char    Digits[MAX_DIGITS];
+  uint8_t NumDigits = 0;
+  uint8_t FieldLength;
+
+  do
+  {
+    Digits[NumDigits++] = (char)('0' + (Value % 10));
+    Value /= 10;
+  } while (Value != 0);
+
+  FieldLength = NumDigits + (Negative ? 1 : 0);
+  while (FieldLength++ < Width)
+  {
+    PutChar(pTC, ' ');
+  }
+  if (Negative)
+  {
+    PutChar(pTC, '-');
+  }
+  while (NumDigits > 0)
+  {
+    PutChar(pTC, Digits[--NumDigits]);
+  }
+}
+
+/***************************************************************************
+ module test harness, checks against snprintf and times the two
+ gcc -O2 -DTEST -DHOST_TEST -IFrameworkHeaders -IProjectHeaders \
+     ProjectSource/TextComposer.c -o composer_test
+ ***************************************************************************/
+#if defined(TEST) && defined(HOST_TEST)
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+
+#define LINE_SIZE 17
+#define NUM_LOOPS 1000000
+
+// the instruction line as InstructionService builds it
+static void Compose(char *pLine, uint32_t Points)
+{
+  TextComposer_t Line;
+
+  TC_Begin(&Line, pLine, LINE_SIZE);
+  TC_PutText(&Line, "Squeeze", 12);
+  TC_PutUnsigned(&Line, Points, 2);
+  TC_PutText(&Line, "pt", 0);
+}
+
+int main(void)
+{
+  static const int32_t Values[] =
+  {
+    0, 7, -7, 42, -42, 99, 100, 65535, 2147483647, -2147483647 - 1
+  };
+  static const uint8_t Widths[] = { 0, 1, 2, 5, 12 };
+  char Expected[520];  // room for any width printf could be asked for
+  char Line[64];
+  char Small[6];
+  TextComposer_t Composer;
+  volatile uint32_t Sink = 0;
+  double Start;
+  double Composed;
+  double Printed;
+  bool Passed = true;
+  uint32_t i;
+  uint8_t v;
+  uint8_t w;
+
+  // every width and value matches printf
+  for (v = 0; v < sizeof(Values) / sizeof(Values[0]); v++)
+  {
+    for (w = 0; w < sizeof(Widths); w++)
+    {
+      snprintf(Expected, sizeof(Expected), "[%*ld|%-*s]", Widths[w],
+          (long)Values[v], Widths[w], "ab");
+      TC_Begin(&Composer, Line, sizeof(Line));
+      TC_PutText(&Composer, "[", 0);
+      TC_PutInt(&Composer, Values[v], Widths[w]);
+      TC_PutText(&Composer, "|", 0);
+      TC_PutText(&Composer, "ab", Widths[w]);
+      TC_PutText(&Composer, "]", 0);
+      Passed &= Check((strcmp(Line, Expected) == 0) &&
+                      (TC_End(&Composer) == strlen(Expected)), Expected);
+    }
+  }
+  TC_Begin(&Composer, Line, sizeof(Line));
+  TC_PutUnsigned(&Composer, 4294967295u, 0);
+  Passed &= Check(strcmp(Line, "4294967295") == 0, "largest unsigned");
+
+  // the line is cut at the buffer and stays terminated
+  TC_Begin(&Composer, Small, sizeof(Small));
+  TC_PutText(&Composer, "abc", 0);
+  TC_PutUnsigned(&Composer, 12345, 0);
+  Passed &= Check((strcmp(Small, "abc12") == 0) && (TC_End(&Composer) == 5),
+                  "truncation");
+
+  // the old hand padded instruction strings come out the same
+  for (i = 0; i < 100; i++)
+  {
+    snprintf(Expected, sizeof(Expected),
+        (i >= 10) ? "Squeeze     %dpt" : "Squeeze      %dpt", (int)i);
+    Compose(Line, i);
+    Passed &= Check(strcmp(Line, Expected) == 0, Expected);
+  }
+
+  Start = Seconds();
+  for (i = 0; i < NUM_LOOPS; i++)
+  {
+    Compose(Line, i % 100);
+    Sink += (uint8_t)Line[13];
+  }
+  Composed = (Seconds() - Start) * 1e9 / NUM_LOOPS;
+
+  Start = Seconds();
+  for (i = 0; i < NUM_LOOPS; i++)
+  {
+    snprintf(Line, LINE_SIZE, "%-12s%2upt", "Squeeze", (unsigned)(i % 100));
+    Sink += (uint8_t)Line[13];
+  }
+  Printed = (Seconds() - Start) * 1e9 / NUM_LOOPS;
+
+  fprintf(stdout, "instruction line: composer %.0f ns, snprintf %.0f ns\n",
+      Composed, Printed);
+  puts(Passed ? "PASS" : "FAIL");
+  return Passed ? 0 : 1;
+}
+#endif // TEST && HOST_TEST
+/*------------------------------ End of file ------------------------------*/
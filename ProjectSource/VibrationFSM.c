@@ -14,6 +14,8 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 21:00 mp      added QueryVibrationFSM for the shell
+ 10/18/26 19:15 mp      banner goes through LOG_INFO, compiled out of production
  01/15/12 11:12 jec      revisions for Gen2 framework
  11/07/11 11:26 jec      made the queue static
  10/30/11 17:59 jec      fixed references to CurrentEvent in RunTemplateSM()
@@ -28,6 +30,9 @@
 #include "VibrationFSM.h"
 #include "PIC32_AD_Lib.h"
 #include "PWM_PIC32.h"
+#define ES_LOG_CHANNEL LOG_CH_VIBRATION
+#define ES_LOG_LEVEL   LOG_LEVEL_VIBRATION
+#include "ES_Log.h"
 
 /*----------------------------- Module Defines ----------------------------*/
 
@@ -70,8 +75,7 @@ bool InitVibrationFSM(uint8_t Priority)
     PWMSetup_SetFreqOnTimer(200, _Timer3_);
     PWMSetup_MapChannelToOutputPin(CHANNEL_PWM, PWM_RPB3);
     
-    clrScrn();
-    printf("\rVibration FSM \r\n");
+    LOG_INFO("\x1b[2J\rVibration FSM \r\n");
   
     // put us into the Initial PseudoState
     CurrentState = InitMotorState;
@@ -106,7 +110,7 @@ ES_Event_t RunVibrationFSM(ES_Event_t ThisEvent)
         {
             if (ThisEvent.EventType == ES_INIT)    // only respond to ES_Init
             {
-                printf("\rMotor init\r\n");
+                LOG_INFO("\rMotor init\r\n");
                 PWMOperate_SetDutyOnChannel(0, CHANNEL_PWM);
                 ADC_MultiRead(LastAnalogValue);
                 CurrentState = MotorOFF;
@@ -167,6 +171,25 @@ ES_Event_t RunVibrationFSM(ES_Event_t ThisEvent)
 }
 
 
+/****************************************************************************
+ Function
+     QueryVibrationFSM
+
+ Parameters
+     None
+
+ Returns
+     VibrationState_t The current state of the vibration state machine
+
+ Description
+     returns the current state of the vibration state machine
+
+****************************************************************************/
+VibrationState_t QueryVibrationFSM(void)
+{
+  return CurrentState;
+}
+
 /****************************************************************************
  Function
     CheckAnalogValue
@@ -14,6 +14,7 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "ES_Port.h"
+#include "ES_ShortTimer.h"
 
 
 void main(void)
@@ -22,6 +23,7 @@ void main(void)
 
   _HW_PIC32Init(); // basic PIC hardware init
   // Your hardware initialization function calls go here
+  ES_ShortTimer_Init(); // micro-second timer channels
 
 
   // now initialize the Events and Services Framework and start it running
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""Decode DB_LOG records from the terminal UART.
+
+The PIC32 sends DB_printf text and DB_LOG binary records over the same
+UART. A record is
+
+    0xA5, argument count, format address (4 bytes LE), arguments (4 bytes LE)
+
+where the format address points at a string in the .dblog_fmt section of the
+ELF file. Game telemetry records (0xA6, see GameTelemetry.h) are skipped;
+Tools/telemetry_stats.py reads those. Everything else is passed through as
+text.
+
+    dblog_decode.py dist/default/production/218A.production.elf capture.bin
+    dblog_decode.py 218A.production.elf /dev/ttyUSB0 --baud 115200
+
+History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 21:40 mp      skip game telemetry records
+ 10/18/26 18:30 mp      first pass
+"""
+import argparse
+import re
+import struct
+import sys
+
+DB_LOG_SYNC = 0xA5
+TELEM_SYNC = 0xA6
+DB_LOG_MAX_ARGS = 8
+SHF_ALLOC = 0x2
+SHT_PROGBITS = 1
+SPEC = re.compile(r"%(.)", re.S)
+
+
+def load_sections(elf_path):
+    """Return [(address, bytes)] for every loaded section with contents, and
+    the address range of .dblog_fmt."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 1:
+        sys.exit("%s is not a 32 bit ELF file" % elf_path)
+    endian = "<" if elf[5] == 1 else ">"
+    shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2E)
+
+    headers = [struct.unpack_from(endian + "IIIIIIIIII", elf,
+                                  shoff + i * shentsize)
+               for i in range(shnum)]
+    names = headers[shstrndx]
+    sections = []
+    fmt_range = None
+    for name, kind, flags, addr, offset, size, *_ in headers:
+        if kind != SHT_PROGBITS or not flags & SHF_ALLOC:
+            continue
+        start = names[4] + name
+        sec_name = elf[start:elf.index(b"\0", start)].decode()
+        sections.append((addr, elf[offset:offset + size]))
+        if sec_name == ".dblog_fmt":
+            fmt_range = (addr, addr + size)
+    if fmt_range is None:
+        sys.exit("%s has no .dblog_fmt section" % elf_path)
+    return sections, fmt_range
+
+
+def string_at(sections, addr):
+    """The NUL terminated string at a target address, or None."""
+    for base, data in sections:
+        if base <= addr < base + len(data):
+            end = data.find(b"\0", addr - base)
+            return data[addr - base:end].decode("ascii", "replace")
+    return None
+
+
+def render(sections, fmt, args):
+    """Apply args to a DB_printf style format."""
+    args = iter(args)
+
+    def convert(match):
+        spec = match.group(1)
+        if spec == "%":
+            return "%"
+        word = next(args, 0)
+        if spec == "d":
+            return str(word - (1 << 32) if word & 0x80000000 else word)
+        if spec == "u":
+            return str(word)
+        if spec == "x":
+            return "%x" % word
+        if spec == "c":
+            return chr(word & 0xFF)
+        if spec == "s":
+            text = string_at(sections, word)
+            return text if text is not None else "(0x%08x)" % word
+        return "BAD"
+
+    return SPEC.sub(convert, fmt)
+
+
+def decode(read, sections, fmt_range, out):
+    pending = b""
+    while True:
+        chunk = read()
+        if not chunk:
+            break
+        pending += chunk
+        while pending:
+            sync = min((i for i in (pending.find(bytes([DB_LOG_SYNC])),
+                                    pending.find(bytes([TELEM_SYNC])))
+                        if i >= 0), default=-1)
+            if sync < 0:
+                out.write(pending.decode("ascii", "replace"))
+                pending = b""
+                break
+            out.write(pending[:sync].decode("ascii", "replace"))
+            pending = pending[sync:]
+            if pending[0] == TELEM_SYNC:
+                # sync, length, then length bytes and a CRC
+                if len(pending) < 2 or len(pending) < pending[1] + 3:
+                    break
+                pending = pending[pending[1] + 3:]
+                continue
+            if len(pending) < 6:
+                break
+            count = pending[1]
+            length = 6 + 4 * count
+            if count > DB_LOG_MAX_ARGS:
+                out.write("<bad record>")
+                pending = pending[1:]
+                continue
+            if len(pending) < length:
+                break
+            fmt_addr, *args = struct.unpack_from("<%dI" % (count + 1), pending, 2)
+            if not fmt_range[0] <= fmt_addr < fmt_range[1]:
+                out.write("<unknown format 0x%08x>" % fmt_addr)
+                pending = pending[1:]
+                continue
+            out.write(render(sections, string_at(sections, fmt_addr), args))
+            pending = pending[length:]
+        out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("elf", help="the ELF file that is running")
+    parser.add_argument("source", help="a capture file or a serial port")
+    parser.add_argument("--baud", type=int, default=115200)
+    opts = parser.parse_args()
+
+    sections, fmt_range = load_sections(opts.elf)
+    if opts.source.startswith("/dev/") or opts.source.upper().startswith("COM"):
+        import serial  # pyserial, only needed for live capture
+        port = serial.Serial(opts.source, opts.baud, timeout=None)
+        read = lambda: port.read(max(1, port.in_waiting))
+    else:
+        capture = open(opts.source, "rb")
+        read = lambda: capture.read(256)
+    try:
+        decode(read, sections, fmt_range, sys.stdout)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""Encode frame sequences into ProjectSource/Animations.c for AnimPlayer.
+
+Each sequence is given as Name,PeriodMs,Column,Frames:
+
+    encode_anim.py ProjectSource/Animations.c \\
+        IdleAnim,60,32,Tools/anims/idle.txt
+
+Frames is a text file, or a glob of PBM images (P1 or P4) taken in sorted
+order, one frame each. In a text file a frame is 8 lines, '#' for a lit LED
+and anything else for a dark one, with blank lines and lines starting with
+';' skipped. Frames are 8 rows high and the same width, padded on the right
+to whole modules of 8 columns. Give the sequences in the order of AnimId_t
+in AnimPlayer.h.
+
+Each frame is stored as a byte with a bit for each row that differs from
+the frame before, then those rows run length encoded, see AnimPlayer.h.
+The first frame stores every row so that the sequence can loop.
+
+History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 23:58 mp      first pass
+"""
+import glob
+import sys
+
+ROWS = 8
+MAX_RUN = 128
+
+HEADER = """\
+/****************************************************************************
+ Module
+   Animations.c
+
+ Description
+   Frame sequences for AnimPlayer, see AnimPlayer.h.
+
+ Notes
+   Generated by Tools/encode_anim.py, do not edit:
+{sources}****************************************************************************/
+#ifndef HOST_TEST
+#include <xc.h>
+#else
+#include <stdint.h>
+#endif
+#include "AnimPlayer.h"
+"""
+
+
+def pad(frame):
+    """Pads every row of a frame of 0/1 lists to whole modules."""
+    width = max(len(row) for row in frame)
+    width = (width + 7) // 8 * 8
+    return [row + [0] * (width - len(row)) for row in frame]
+
+
+def load_text(path):
+    frames, rows = [], []
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip("\r\n")
+            if not line or line.startswith(";"):
+                continue
+            rows.append([1 if c == "#" else 0 for c in line])
+            if len(rows) == ROWS:
+                frames.append(pad(rows))
+                rows = []
+    if rows:
+        sys.exit("%s: the last frame is not %d rows" % (path, ROWS))
+    return frames
+
+
+def pbm_tokens(data):
+    """The header fields of a PBM and the offset just past them."""
+    fields, i = [], 0
+    while len(fields) < 3:
+        while data[i:i + 1].isspace():
+            i += 1
+        if data[i:i + 1] == b"#":
+            while data[i:i + 1] not in (b"\n", b""):
+                i += 1
+            continue
+        start = i
+        while not data[i:i + 1].isspace():
+            i += 1
+        fields.append(data[start:i])
+    return fields, i + 1
+
+
+def load_pbm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    (magic, width, height), start = pbm_tokens(data)
+    width, height = int(width), int(height)
+    if height != ROWS:
+        sys.exit("%s: %d rows, not %d" % (path, height, ROWS))
+    if magic == b"P1":
+        bits = [int(c) for c in data[start - 1:].decode() if c in "01"]
+        frame = [bits[r * width:(r + 1) * width] for r in range(ROWS)]
+    elif magic == b"P4":
+        stride = (width + 7) // 8
+        frame = []
+        for r in range(ROWS):
+            line = data[start + r * stride:start + (r + 1) * stride]
+            frame.append([(line[x // 8] >> (7 - x % 8)) & 1
+                          for x in range(width)])
+    else:
+        sys.exit("%s: not a PBM" % path)
+    return pad(frame)
+
+
+def load_frames(source):
+    if source.endswith(".txt"):
+        frames = load_text(source)
+    else:
+        paths = sorted(glob.glob(source))
+        if not paths:
+            sys.exit("no files match %s" % source)
+        frames = [load_pbm(path) for path in paths]
+    if not frames:
+        sys.exit("%s: no frames" % source)
+    if len(set(len(frame[0]) for frame in frames)) != 1:
+        sys.exit("%s: the frames are not all the same width" % source)
+    return frames
+
+
+def row_bytes(row):
+    """A row of pixels as bytes, left module first, left column in bit 7."""
+    return [sum(bit << (7 - i) for i, bit in enumerate(row[m:m + 8]))
+            for m in range(0, len(row), 8)]
+
+
+def rle(data):
+    """Runs of 3 or more as 0x80 + n and a byte, the rest as n and n + 1
+    bytes as they are."""
+    out, literal, i = [], [], 0
+
+    def flush():
+        while literal:
+            chunk = literal[:MAX_RUN]
+            del literal[:MAX_RUN]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    while i < len(data):
+        run = 1
+        while (i + run < len(data) and data[i + run] == data[i]
+               and run < MAX_RUN):
+            run += 1
+        if run >= 3:
+            flush()
+            out.extend([0x80 + run - 1, data[i]])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush()
+    return out
+
+
+def encode(frames):
+    out, last = [], None
+    for frame in frames:
+        rows = [row_bytes(row) for row in frame]
+        changed = [r for r in range(ROWS) if last is None or rows[r] != last[r]]
+        out.append(sum(1 << r for r in changed))
+        for r in changed:
+            out.extend(rle(rows[r]))
+        last = rows
+    return out
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__.split("\n\n")[2])
+    anims = []
+    for spec in sys.argv[2:]:
+        try:
+            name, period, column, source = spec.split(",", 3)
+            period, column = int(period), int(column)
+        except ValueError:
+            sys.exit("expected Name,PeriodMs,Column,Frames, not %s" % spec)
+        frames = load_frames(source)
+        anims.append((name, period, column, source, frames, encode(frames)))
+
+    sources = "".join("     %s from %s\n" % (a[0], a[3]) for a in anims)
+    with open(sys.argv[1], "w", newline="\n") as out:
+        out.write(HEADER.format(sources=sources))
+        for name, period, column, source, frames, data in anims:
+            out.write("\nstatic const uint8_t %sData[%d] = {\n"
+                      % (name, len(data)))
+            for i in range(0, len(data), 12):
+                out.write("  " + ", ".join("0x%02x" % b
+                                           for b in data[i:i + 12]))
+                out.write(",\n" if i + 12 < len(data) else "\n")
+            out.write("};\n")
+            out.write("const Anim_t %s = { %sData, %d, %d, %d, %d };\n"
+                      % (name, name, len(frames), period, column,
+                         len(frames[0][0]) // 8))
+            raw = len(frames) * ROWS * len(frames[0][0]) // 8
+            print("%s: %d frames, %d bytes (%d raw)"
+                  % (name, len(frames), len(data), raw))
+        out.write("\nconst Anim_t * const Animations[NUM_ANIMATIONS] = {\n")
+        out.write(",\n".join("  &%s" % a[0] for a in anims))
+        out.write("\n};\n")
+
+
+if __name__ == "__main__":
+    main()
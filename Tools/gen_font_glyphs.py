@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Expand the packed font4x6 table into ProjectSource/FontGlyphs.c.
+
+font4x6 in FontStuff.c packs each character into 2 bytes that getFontLine
+unpacks a row at a time. This decodes every character the same way, once,
+into 8 rows of pixels, so DM_AddChar2Display can OR a glyph into the frame
+without decoding it. Run it again after changing font4x6.
+
+    gen_font_glyphs.py ProjectSource/FontStuff.c ProjectSource/FontGlyphs.c
+
+History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 22:40 mp      first pass
+"""
+import re
+import sys
+
+GLYPH_ROWS = 8
+FIRST_CHAR = 32
+NUM_GLYPHS = 96
+
+HEADER = """\
+/****************************************************************************
+ Module
+   FontGlyphs.c
+
+ Description
+   font4x6 expanded to 8 rows per character, see FontStuff.h.
+
+ Notes
+   Generated by Tools/gen_font_glyphs.py from font4x6 in FontStuff.c, do not
+   edit. FontStuff.c checks it against getFontLine in its host test.
+****************************************************************************/
+#ifndef HOST_TEST
+#include <xc.h>
+#else
+#include <stdint.h>
+#endif
+#include "FontStuff.h"
+
+const uint8_t FontGlyphs[FONT_NUM_GLYPHS][FONT_GLYPH_ROWS] = {
+"""
+
+
+def load_font(source):
+    """Return the (byte 0, byte 1) pairs and comments of font4x6."""
+    body = source[source.index("font4x6[96][2]"):]
+    body = body[:body.index("};")]
+    entries = re.findall(r"\{\s*(0[xX][0-9a-fA-F]+)\s*,\s*(0[xX][0-9a-fA-F]+)"
+                         r"\s*\}\s*,?\s*(/\*.*?\*/)", body)
+    if len(entries) != NUM_GLYPHS:
+        sys.exit("expected %d characters in font4x6, found %d"
+                 % (NUM_GLYPHS, len(entries)))
+    return [(int(a, 16), int(b, 16), note) for a, b, note in entries]
+
+
+def font_line(pair, line):
+    """Row line of a character, exactly as getFontLine computes it."""
+    first, second = pair
+    if second & 1:         # descender, the glyph sits 1 row lower
+        line -= 1
+    if line == 0:
+        pixel = first >> 4
+    elif line == 1:
+        pixel = first >> 1
+    elif line == 2:
+        return ((first & 0x03) << 2) | (second & 0x02)
+    elif line == 3:
+        pixel = second >> 4
+    elif line == 4:
+        pixel = second >> 1
+    else:
+        pixel = 0
+    return pixel & 0xE
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__.split("\n\n")[2])
+    with open(sys.argv[1]) as f:
+        font = load_font(f.read())
+    with open(sys.argv[2], "w", newline="\n") as out:
+        out.write(HEADER)
+        for index, (first, second, note) in enumerate(font):
+            rows = ", ".join("0x%02x" % font_line((first, second), line)
+                             for line in range(GLYPH_ROWS))
+            comma = "," if index < NUM_GLYPHS - 1 else " "
+            out.write(" { %s }%s  %s\n" % (rows, comma, note))
+        out.write("};\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""Replay scripted events into the game over the terminal UART.
+
+Each script line is
+
+    <delay ms> <service number | all> <event name | number> [param]
+
+for example
+
+    # start a game and touch twice (service 2 is ModeServiceFSM)
+    0    all  ES_GAME
+    500  2    ES_Touch  1
+    250  2    ES_Touch  2
+
+Event names are read from the ES_EventType_t enum in ES_Configure.h, so the
+script keeps working when events are added. Each event goes out as an
+injection frame (see ES_Inject.h):
+
+    0xAA, 5, service (0xFF = all), type (2 bytes LE), param (2 bytes LE), CRC-8
+
+    inject_events.py script.txt /dev/ttyUSB0
+    inject_events.py script.txt /dev/ttyUSB0 --loop 100 --rate 2000
+    inject_events.py script.txt --out frames.bin
+
+--rate ignores the delays in the script and sends frames at a fixed rate,
+for load testing the state machines; 115200 baud carries about 1400 frames
+per second.
+
+History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 00:50 mp      the example sends the touches to ModeServiceFSM
+ 10/18/26 20:45 mp      first pass
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+import time
+
+INJECT_SYNC = 0xAA
+INJECT_BROADCAST = 0xFF
+INJECT_PAYLOAD_LEN = 5
+DEFAULT_CONFIGURE = os.path.join(os.path.dirname(__file__), "..",
+                                 "FrameworkHeaders", "ES_Configure.h")
+
+
+def crc8(data):
+    """CRC-8, polynomial 0x07, initial value 0, as ES_Inject_CRC8."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def frame(service, event_type, param):
+    body = struct.pack("<BBHH", INJECT_PAYLOAD_LEN, service, event_type, param)
+    return bytes([INJECT_SYNC]) + body + bytes([crc8(body)])
+
+
+def load_event_names(configure_path):
+    """Map the names in the ES_EventType_t enum to their values."""
+    with open(configure_path) as f:
+        text = f.read()
+    body = re.search(r"typedef\s+enum\s*\{(.*?)\}\s*ES_EventType_t", text, re.S)
+    if body is None:
+        sys.exit("no ES_EventType_t in %s" % configure_path)
+    body = re.sub(r"/\*.*?\*/|//[^\n]*", "", body.group(1), flags=re.S)
+    names = {}
+    value = 0
+    for entry in filter(None, (e.strip() for e in body.split(","))):
+        name, _, explicit = entry.partition("=")
+        if explicit.strip():
+            value = int(explicit.strip(), 0)
+        names[name.strip()] = value
+        value += 1
+    return names
+
+
+def load_script(script_path, names):
+    """Return [(delay in s, frame bytes)] for the script."""
+    steps = []
+    with open(script_path) as f:
+        for number, line in enumerate(f, 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+            if len(fields) not in (3, 4):
+                sys.exit("%s:%d: expected delay service event [param]"
+                         % (script_path, number))
+            delay, service, event = fields[:3]
+            param = int(fields[3], 0) if len(fields) == 4 else 0
+            service = INJECT_BROADCAST if service == "all" else int(service, 0)
+            if event in names:
+                event = names[event]
+            elif re.fullmatch(r"\d+|0x[0-9a-fA-F]+", event):
+                event = int(event, 0)
+            else:
+                sys.exit("%s:%d: unknown event %s" % (script_path, number, event))
+            steps.append((int(delay, 0) / 1000.0, frame(service, event, param)))
+    return steps
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("script")
+    parser.add_argument("port", nargs="?", help="serial port to send to")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--out", help="write the frames to a file instead")
+    parser.add_argument("--loop", type=int, default=1,
+                        help="times to play the script")
+    parser.add_argument("--rate", type=float,
+                        help="frames per second, ignoring the script delays")
+    parser.add_argument("--configure", default=DEFAULT_CONFIGURE,
+                        help="ES_Configure.h to take event names from")
+    opts = parser.parse_args()
+
+    steps = load_script(opts.script, load_event_names(opts.configure))
+    if opts.out:
+        with open(opts.out, "wb") as f:
+            for _ in range(opts.loop):
+                f.write(b"".join(data for _, data in steps))
+        return
+    if not opts.port:
+        parser.error("give a serial port or --out")
+
+    import serial  # pyserial, only needed when sending
+    port = serial.Serial(opts.port, opts.baud)
+    sent = 0
+    start = time.monotonic()
+    due = start
+    for _ in range(opts.loop):
+        for delay, data in steps:
+            due += 1.0 / opts.rate if opts.rate else delay
+            pause = due - time.monotonic()
+            if pause > 0:
+                time.sleep(pause)
+            port.write(data)
+            sent += 1
+    port.flush()
+    elapsed = time.monotonic() - start
+    print("%d frames in %.2fs, %.0f frames/s"
+          % (sent, elapsed, sent / elapsed if elapsed else 0))
+
+
+if __name__ == "__main__":
+    main()
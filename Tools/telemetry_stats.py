@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Reaction time statistics from game telemetry captures.
+
+Reads the TELEM_* records (see GameTelemetry.h) out of one or more captures
+of the terminal UART and reports, for each sensor, how often the lit module
+was triggered in time and how long players took to do it. Text and DB_LOG
+records in the capture are skipped. A record is
+
+    0xA6, length, type, session (2 bytes LE), payload, CRC-8
+
+    telemetry_stats.py capture1.bin capture2.bin
+    telemetry_stats.py captures/*.bin --hist --csv rounds.csv
+
+History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 21:40 mp      first pass
+"""
+import argparse
+import csv
+import struct
+import sys
+
+TELEM_SYNC = 0xA6
+TELEM_GAME_START, TELEM_ROUND, TELEM_GAME_END = 1, 2, 3
+# payload lengths, by type
+PAYLOAD_LEN = {TELEM_GAME_START: 0, TELEM_ROUND: 5, TELEM_GAME_END: 5}
+MODULES = ["Touch", "Shake", "Squeeze", "Wave"]           # Module_t
+OUTCOMES = ["hit", "timed out", "inactive", "game over"]  # RoundOutcome_t
+HIST_BUCKET_MS = 250
+
+
+def crc8(data):
+    """CRC-8, polynomial 0x07, initial value 0, as ES_Inject_CRC8."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def records(data):
+    """Yield (type, session, payload) for each good record in data."""
+    pos = 0
+    while True:
+        pos = data.find(bytes([TELEM_SYNC]), pos)
+        if pos < 0 or pos + 2 > len(data):
+            return
+        length = data[pos + 1]
+        kind = data[pos + 2] if pos + 2 < len(data) else None
+        end = pos + 2 + length
+        if (PAYLOAD_LEN.get(kind, -1) + 3 != length or end >= len(data)
+                or crc8(data[pos + 1:end]) != data[end]):
+            pos += 1    # not a record, or a damaged one
+            continue
+        session, = struct.unpack_from("<H", data, pos + 3)
+        yield kind, session, data[pos + 5:end]
+        pos = end + 1
+
+
+def load(paths):
+    """Return the completed games as dicts with 'rounds' and 'points'."""
+    games = []
+    for path in paths:
+        with open(path, "rb") as f:
+            data = f.read()
+        game = None
+        for kind, session, payload in records(data):
+            if kind == TELEM_GAME_START:
+                game = {"source": path, "session": session, "rounds": []}
+            elif game is None or session != game["session"]:
+                continue    # the start of this game was lost
+            elif kind == TELEM_ROUND:
+                number, module, outcome, reaction = struct.unpack("<BBBH",
+                                                                  payload)
+                game["rounds"].append((number, module, outcome, reaction))
+            elif kind == TELEM_GAME_END:
+                _, game["points"], game["length"] = struct.unpack("<BHH",
+                                                                  payload)
+                games.append(game)
+                game = None
+    return games
+
+
+def percentile(ordered, fraction):
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+def report(games, show_hist, out):
+    rounds = [r for g in games for r in g["rounds"]]
+    points = sorted(g["points"] for g in games)
+    out.write("%d games, %d rounds\n" % (len(games), len(rounds)))
+    if not games:
+        return
+    out.write("points: mean %.1f, median %d, best %d\n\n"
+              % (sum(points) / len(points), percentile(points, 0.5), points[-1]))
+    out.write("%-8s %6s %6s %6s %7s %7s %7s %7s\n" % (
+        "sensor", "rounds", "hit%", "mean", "p10", "p50", "p90", "max"))
+    for module, name in enumerate(MODULES):
+        mine = [r for r in rounds if r[1] == module]
+        hits = sorted(r[3] for r in mine if r[2] == 0)
+        if not mine:
+            continue
+        if not hits:
+            out.write("%-8s %6d %6.1f\n" % (name, len(mine), 0.0))
+            continue
+        out.write("%-8s %6d %6.1f %6.0f %7d %7d %7d %7d\n" % (
+            name, len(mine), 100.0 * len(hits) / len(mine),
+            sum(hits) / len(hits), percentile(hits, 0.1),
+            percentile(hits, 0.5), percentile(hits, 0.9), hits[-1]))
+        if show_hist:
+            counts = {}
+            for ms in hits:
+                counts[ms // HIST_BUCKET_MS] = counts.get(ms // HIST_BUCKET_MS, 0) + 1
+            scale = 50.0 / max(counts.values())
+            for bucket in range(max(counts) + 1):
+                count = counts.get(bucket, 0)
+                out.write("  %5d ms %6d %s\n" % (bucket * HIST_BUCKET_MS, count,
+                                                "#" * int(count * scale + 0.5)))
+    out.write("\nround outcomes: %s\n" % ", ".join(
+        "%s %d" % (name, sum(1 for r in rounds if r[2] == outcome))
+        for outcome, name in enumerate(OUTCOMES)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("captures", nargs="+")
+    parser.add_argument("--hist", action="store_true",
+                        help="print a reaction time histogram for each sensor")
+    parser.add_argument("--csv", help="also write every round to this file")
+    opts = parser.parse_args()
+
+    games = load(opts.captures)
+    report(games, opts.hist, sys.stdout)
+    if opts.csv:
+        with open(opts.csv, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["source", "session", "round", "sensor", "outcome",
+                             "reaction_ms", "points"])
+            for g in games:
+                for number, module, outcome, reaction in g["rounds"]:
+                    writer.writerow([g["source"], g["session"], number,
+                                     MODULES[module] if module < len(MODULES)
+                                     else module, OUTCOMES[outcome]
+                                     if outcome < len(OUTCOMES) else outcome,
+                                     reaction, g["points"]])
+
+
+if __name__ == "__main__":
+    main()